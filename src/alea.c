@@ -0,0 +1,48 @@
+#include "alea.h"
+
+/**
+ * @brief Fait tourner les bits d'un mot de 64 bits vers la gauche.
+ * @param x représente le mot à tourner.
+ * @param k représente le nombre de bits.
+ * @return le mot tourné.
+ */
+static inline uint64_t rotl(uint64_t x, int k) {
+  return (x << k) | (x >> (64 - k));
+}
+
+/**
+ * @brief Implémentation de la fonction initAlea.
+ */
+void initAlea(Alea *alea, uint64_t graine) {
+  uint64_t z;
+  // On remplit l'état avec splitmix64 pour qu'il ne soit jamais nul
+  for (int i = 0; i < 4; i++) {
+    z = (graine += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    alea->s[i] = z ^ (z >> 31);
+  }
+}
+
+/**
+ * @brief Implémentation de la fonction suivantAlea.
+ */
+uint64_t suivantAlea(Alea *alea) {
+  uint64_t *s = alea->s;
+  uint64_t res = rotl(s[1] * 5, 7) * 9, t = s[1] << 17;
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = rotl(s[3], 45);
+  return res;
+}
+
+/**
+ * @brief Implémentation de la fonction tireAlea.
+ */
+uint32_t tireAlea(Alea *alea, uint32_t n) {
+  // On ramène les 32 bits de poids fort dans [0, n) par multiplication
+  return ((suivantAlea(alea) >> 32) * n) >> 32;
+}
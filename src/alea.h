@@ -0,0 +1,34 @@
+#ifndef ALEA_H
+#define ALEA_H
+
+#include <stdint.h>
+
+// Structure de l'état d'un générateur pseudo-aléatoire xoshiro256**
+typedef struct alea {
+  uint64_t s[4];
+} Alea;
+
+/**
+ * @brief Initialise l'état du générateur à partir d'une graine. Deux générateurs initialisés avec
+ * la même graine donnent la même suite de nombres.
+ * @param alea représente le générateur à initialiser. (Paramètre modifié)
+ * @param graine représente la graine du générateur.
+ */
+void initAlea(Alea *alea, uint64_t graine);
+
+/**
+ * @brief Tire le nombre pseudo-aléatoire suivant du générateur.
+ * @param alea représente le générateur. (Paramètre modifié)
+ * @return un nombre sur 64 bits.
+ */
+uint64_t suivantAlea(Alea *alea);
+
+/**
+ * @brief Tire un nombre pseudo-aléatoire entre 0 et n - 1.
+ * @param alea représente le générateur. (Paramètre modifié)
+ * @param n représente le nombre de valeurs possibles.
+ * @return un nombre entre 0 et n - 1.
+ */
+uint32_t tireAlea(Alea *alea, uint32_t n);
+
+#endif
@@ -0,0 +1,361 @@
+#include <dirent.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "forme.h"
+#include "ordonnanceur.h"
+#include "partie.h"
+#include "rejeu.h"
+
+// Noms des formes dans l'ordre de la table LES_FORMES
+static const char NOMS_FORMES[NB_FORMES + 1] = "LZSJTOI";
+
+// Structure des statistiques d'un rejeu (ou de tous les rejeux une fois agrégées)
+typedef struct {
+  uint32_t fichiers, erreurs;
+  uint64_t octets, tours;
+  // Nombre de parties (une de plus à chaque recommencement) et de parties perdues
+  uint32_t parties, fins;
+  // Formes posées par forme et dépôts par nombre de lignes supprimées
+  uint64_t pieces[NB_FORMES], lignes[NB_CASES_FORME + 1];
+  // Parties perdues par forme posée en dernier et total des trous du terrain à la fin
+  uint32_t finsPar[NB_FORMES];
+  uint64_t trousFins;
+  uint32_t scoreMax;
+} Resultat;
+
+// Structure des paramètres communs à toutes les analyses
+typedef struct {
+  char **chemins;
+  uint32_t nbChemins, capacite;
+  Resultat *resultats;
+} Analyse;
+
+/**
+ * @brief Rejoue un rejeu sur le moteur sans affichage et compte ses statistiques.
+ * @param rejeu représente le rejeu ouvert. (Paramètre modifié)
+ * @param res représente l'espace où stocker les statistiques. (Paramètre modifié)
+ * @return 0 si tous s'est bien passée et -1 si non.
+ */
+static int8_t analyseRejeu(Rejeu *rejeu, Resultat *res) {
+  Evenement evts[MAX_EVENEMENTS];
+  Partie partie;
+  uint8_t id, etaitTermine;
+  uint16_t nb, i;
+  int8_t errEtColl = 0;
+  if (initPartie(&partie, rejeu->nbLignes, rejeu->nbColonnes, rejeu->graine, rejeu->avecIA))
+    return -1;
+  res->parties = 1;
+  while (!estFiniRejeu(rejeu)) {
+    // On note la forme courante avant le tour, c'est elle qui sera posée
+    id = partie.modele->forme.id, etaitTermine = partie.estTermine;
+    nb = lisEvenements(rejeu, partie.tour, evts, MAX_EVENEMENTS);
+    for (i = 0; i < nb && evts[i] != ECHAP; i++)
+      if (evts[i] == TOUCHE_R && (partie.estEnPause || partie.estTermine))
+        res->parties++;
+    // ECHAP marque la fin de la partie enregistrée
+    if (i < nb)
+      break;
+    if ((errEtColl = joueTour(&partie, evts, nb)) == -1)
+      break;
+    if (errEtColl == 1) {
+      res->pieces[id]++;
+      res->lignes[__builtin_popcountll(getLignesSupprimees(partie.modele))]++;
+      if (getScore(partie.modele) > res->scoreMax)
+        res->scoreMax = getScore(partie.modele);
+    }
+    if (!etaitTermine && partie.estTermine) {
+      res->fins++, res->finsPar[id]++;
+      res->trousFins += getNbTrous(partie.modele);
+    }
+  }
+  res->tours = partie.tour;
+  detruitPartie(&partie);
+  return errEtColl == -1 ? -1 : 0;
+}
+
+/**
+ * @brief Analyse un fichier de rejeu : il est projeté en mémoire avec mmap et décodé sur place,
+ * sans être lu dans un tampon.
+ * @param indice représente le numéro du fichier.
+ * @param ouvrier représente le numéro de l'ouvrier qui l'analyse.
+ * @param arg représente les paramètres de l'analyse.
+ */
+static void analyseFichier(uint32_t indice, uint16_t ouvrier, void *arg) {
+  Analyse *a = (Analyse *)arg;
+  Resultat *res = &a->resultats[indice];
+  const char *chemin = a->chemins[indice];
+  struct stat infos;
+  Rejeu *rejeu = NULL;
+  void *octets = MAP_FAILED;
+  int fd;
+
+  res->fichiers = res->erreurs = 1;
+  // Projection du fichier
+  if ((fd = open(chemin, O_RDONLY)) < 0 || fstat(fd, &infos) || !infos.st_size ||
+      (octets = mmap(NULL, infos.st_size, PROT_READ, MAP_PRIVATE, fd, 0)) == MAP_FAILED) {
+    fprintf(stderr, "Erreur à l'analyse de %s : Projection du fichier échouée\n", chemin);
+    if (fd >= 0)
+      close(fd);
+    return;
+  }
+  close(fd);
+  // Le fichier est lu une seule fois du début à la fin
+  madvise(octets, infos.st_size, MADV_SEQUENTIAL);
+  res->octets = infos.st_size;
+  // Décodage et simulation
+  rejeu = ouvreRejeuMemoire(octets, infos.st_size);
+  if (rejeu && !analyseRejeu(rejeu, res))
+    res->erreurs = 0;
+  else
+    fprintf(stderr, "Erreur à l'analyse de %s\n", chemin);
+  fermeRejeu(rejeu);
+  munmap(octets, infos.st_size);
+}
+
+/**
+ * @brief Ajoute un chemin à la liste des fichiers à analyser.
+ * @param a représente les paramètres de l'analyse. (Paramètre modifié)
+ * @param chemin représente le chemin à ajouter (il est copié).
+ * @return 0 si tous s'est bien passée et -1 si non.
+ */
+static int8_t ajouteChemin(Analyse *a, const char *chemin) {
+  char **chemins;
+  if (a->nbChemins == a->capacite) {
+    chemins = (char **)realloc(a->chemins, (2 * a->capacite + 64) * sizeof(char *));
+    if (!chemins) {
+      perror("Erreur à la liste des fichiers : Allocation mémoire échouée");
+      return -1;
+    }
+    a->chemins = chemins, a->capacite = 2 * a->capacite + 64;
+  }
+  if (!(a->chemins[a->nbChemins] = strdup(chemin))) {
+    perror("Erreur à la liste des fichiers : Allocation mémoire échouée");
+    return -1;
+  }
+  a->nbChemins++;
+  return 0;
+}
+
+/**
+ * @brief Ajoute un fichier ou les fichiers d'un répertoire (sans ses sous répertoires) à la liste
+ * des fichiers à analyser.
+ * @param a représente les paramètres de l'analyse. (Paramètre modifié)
+ * @param chemin représente le chemin du fichier ou du répertoire.
+ * @return 0 si tous s'est bien passée et -1 si non.
+ */
+static int8_t ajouteFichiers(Analyse *a, const char *chemin) {
+  char fichier[4096];
+  struct stat infos;
+  struct dirent *entree;
+  DIR *rep;
+  int8_t err = 0;
+  if (stat(chemin, &infos)) {
+    perror(chemin);
+    return -1;
+  }
+  if (!S_ISDIR(infos.st_mode))
+    return ajouteChemin(a, chemin);
+  if (!(rep = opendir(chemin))) {
+    perror(chemin);
+    return -1;
+  }
+  while (!err && (entree = readdir(rep))) {
+    snprintf(fichier, sizeof(fichier), "%s/%s", chemin, entree->d_name);
+    if (!stat(fichier, &infos) && S_ISREG(infos.st_mode))
+      err = ajouteChemin(a, fichier);
+  }
+  closedir(rep);
+  return err;
+}
+
+/**
+ * @brief Agrège les statistiques de tous les rejeux.
+ * @param a représente les paramètres de l'analyse contenant les résultats.
+ * @param total représente l'espace où stocker les statistiques agrégées. (Paramètre modifié)
+ */
+static void agrege(Analyse *a, Resultat *total) {
+  memset(total, 0, sizeof(Resultat));
+  for (uint32_t i = 0; i < a->nbChemins; i++) {
+    Resultat *res = &a->resultats[i];
+    total->fichiers += res->fichiers, total->erreurs += res->erreurs;
+    total->octets += res->octets, total->tours += res->tours;
+    total->parties += res->parties, total->fins += res->fins;
+    for (int j = 0; j < NB_FORMES; j++) {
+      total->pieces[j] += res->pieces[j];
+      total->finsPar[j] += res->finsPar[j];
+    }
+    for (int j = 0; j <= NB_CASES_FORME; j++)
+      total->lignes[j] += res->lignes[j];
+    total->trousFins += res->trousFins;
+    if (res->scoreMax > total->scoreMax)
+      total->scoreMax = res->scoreMax;
+  }
+}
+
+/**
+ * @brief Écrit les statistiques agrégées en CSV : une ligne d'en-tête puis une ligne de valeurs.
+ * @param sortie représente le fichier où écrire. (Paramètre modifié)
+ * @param total représente les statistiques agrégées.
+ */
+static void ecritCSV(FILE *sortie, Resultat *total) {
+  uint64_t pieces = 0, lignes = 0;
+  int j;
+  for (j = 0; j < NB_FORMES; j++)
+    pieces += total->pieces[j];
+  for (j = 1; j <= NB_CASES_FORME; j++)
+    lignes += j * total->lignes[j];
+  fprintf(sortie, "fichiers,erreurs,octets,tours,parties,fins,pieces");
+  for (j = 0; j < NB_FORMES; j++)
+    fprintf(sortie, ",pieces_%c", NOMS_FORMES[j]);
+  for (j = 0; j <= NB_CASES_FORME; j++)
+    fprintf(sortie, ",depots_%d_lignes", j);
+  fprintf(sortie, ",lignes_par_piece");
+  for (j = 0; j < NB_FORMES; j++)
+    fprintf(sortie, ",fins_%c", NOMS_FORMES[j]);
+  fprintf(sortie, ",trous_par_fin,score_max\n");
+  fprintf(sortie, "%u,%u,%" PRIu64 ",%" PRIu64 ",%u,%u,%" PRIu64, total->fichiers, total->erreurs,
+          total->octets, total->tours, total->parties, total->fins, pieces);
+  for (j = 0; j < NB_FORMES; j++)
+    fprintf(sortie, ",%" PRIu64, total->pieces[j]);
+  for (j = 0; j <= NB_CASES_FORME; j++)
+    fprintf(sortie, ",%" PRIu64, total->lignes[j]);
+  fprintf(sortie, ",%.4f", pieces ? (double)lignes / pieces : 0);
+  for (j = 0; j < NB_FORMES; j++)
+    fprintf(sortie, ",%u", total->finsPar[j]);
+  fprintf(sortie, ",%.2f,%u\n", total->fins ? (double)total->trousFins / total->fins : 0,
+          total->scoreMax);
+}
+
+/**
+ * @brief Écrit les statistiques agrégées en JSON.
+ * @param sortie représente le fichier où écrire. (Paramètre modifié)
+ * @param total représente les statistiques agrégées.
+ */
+static void ecritJSON(FILE *sortie, Resultat *total) {
+  uint64_t pieces = 0, lignes = 0;
+  int j;
+  for (j = 0; j < NB_FORMES; j++)
+    pieces += total->pieces[j];
+  for (j = 1; j <= NB_CASES_FORME; j++)
+    lignes += j * total->lignes[j];
+  fprintf(sortie,
+          "{\n  \"fichiers\": %u,\n  \"erreurs\": %u,\n  \"octets\": %" PRIu64
+          ",\n  \"tours\": %" PRIu64 ",\n  \"parties\": %u,\n  \"fins\": %u,\n  \"pieces\": %" PRIu64
+          ",\n",
+          total->fichiers, total->erreurs, total->octets, total->tours, total->parties,
+          total->fins, pieces);
+  fprintf(sortie, "  \"pieces_par_forme\": {");
+  for (j = 0; j < NB_FORMES; j++)
+    fprintf(sortie, "%s\"%c\": %" PRIu64, j ? ", " : "", NOMS_FORMES[j], total->pieces[j]);
+  fprintf(sortie, "},\n  \"depots_par_lignes\": [");
+  for (j = 0; j <= NB_CASES_FORME; j++)
+    fprintf(sortie, "%s%" PRIu64, j ? ", " : "", total->lignes[j]);
+  fprintf(sortie, "],\n  \"lignes_par_piece\": %.4f,\n  \"fins_par_forme\": {",
+          pieces ? (double)lignes / pieces : 0);
+  for (j = 0; j < NB_FORMES; j++)
+    fprintf(sortie, "%s\"%c\": %u", j ? ", " : "", NOMS_FORMES[j], total->finsPar[j]);
+  fprintf(sortie, "},\n  \"trous_par_fin\": %.2f,\n  \"score_max\": %u\n}\n",
+          total->fins ? (double)total->trousFins / total->fins : 0, total->scoreMax);
+}
+
+/**
+ * @brief Analyse tous les fichiers en parallèle puis écrit leurs statistiques agrégées.
+ * @param a représente les paramètres de l'analyse avec la liste des fichiers. (Paramètre modifié)
+ * @param nbOuvriers représente le nombre de threads (0 pour un par coeur).
+ * @param sortie représente le fichier où écrire. (Paramètre modifié)
+ * @param format représente le format de sortie, "csv" ou "json".
+ * @return 0 si tous s'est bien passée et -1 si non.
+ */
+static int8_t analyseCorpus(Analyse *a, uint16_t nbOuvriers, FILE *sortie, const char *format) {
+  struct timespec debut, fin;
+  Resultat total;
+  double secondes;
+  a->resultats = (Resultat *)calloc(a->nbChemins, sizeof(Resultat));
+  if (!a->resultats) {
+    perror("Erreur à la création des résultats : Allocation mémoire échouée");
+    return -1;
+  }
+  clock_gettime(CLOCK_MONOTONIC, &debut);
+  if (executeEnParallele(a->nbChemins, nbOuvriers, analyseFichier, a))
+    return -1;
+  clock_gettime(CLOCK_MONOTONIC, &fin);
+  secondes = (fin.tv_sec - debut.tv_sec) + (fin.tv_nsec - debut.tv_nsec) / 1e9;
+  agrege(a, &total);
+  if (!strcmp(format, "csv"))
+    ecritCSV(sortie, &total);
+  else
+    ecritJSON(sortie, &total);
+  fprintf(stderr, "%u fichiers (%.1f Mo, %" PRIu64 " tours) en %.3f s sur %u threads\n",
+          total.fichiers, total.octets / 1e6, total.tours, secondes,
+          nbOuvriers ? nbOuvriers : getNbCoeurs());
+  return 0;
+}
+
+/************************ Programme Principale *************************/
+
+int main(int argc, char **argv) {
+  Analyse a = {NULL, 0, 0, NULL};
+  long nbOuvriers = 0;
+  const char *format = "csv", *fichierSortie = NULL;
+  FILE *sortie = stdout;
+  int8_t err = 0;
+  int opt;
+
+  // Lecture des options
+  while ((opt = getopt(argc, argv, "t:f:o:")) != -1) {
+    switch (opt) {
+      case 't' :
+        nbOuvriers = strtol(optarg, NULL, 10);
+        break;
+      case 'f' :
+        format = optarg;
+        break;
+      case 'o' :
+        fichierSortie = optarg;
+        break;
+      default :
+        err = -1;
+    }
+  }
+  if (err || optind >= argc || (strcmp(format, "csv") && strcmp(format, "json"))) {
+    fprintf(stderr, "Syntaxe : %s [-t threads] [-f {csv, json}] [-o sortie] rejeu...\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  if (nbOuvriers < 0 || nbOuvriers > MAX_OUVRIERS) {
+    fprintf(stderr, "0 <= threads <= %d (0 pour un par coeur)\n", MAX_OUVRIERS);
+    return EXIT_FAILURE;
+  }
+
+  // Liste des fichiers à analyser (les répertoires donnent tous leurs fichiers)
+  for (int i = optind; !err && i < argc; i++)
+    err = ajouteFichiers(&a, argv[i]);
+  if (!err && !a.nbChemins) {
+    fprintf(stderr, "Aucun fichier à analyser\n");
+    err = -1;
+  }
+  if (!err && fichierSortie && !(sortie = fopen(fichierSortie, "w"))) {
+    perror(fichierSortie);
+    sortie = stdout, err = -1;
+  }
+
+  // On analyse tous les fichiers
+  if (!err)
+    err = analyseCorpus(&a, nbOuvriers, sortie, format);
+
+  // Destruction de la liste et des résultats
+  if (sortie != stdout)
+    fclose(sortie);
+  for (uint32_t i = 0; i < a.nbChemins; i++)
+    free(a.chemins[i]);
+  free(a.chemins);
+  free(a.resultats);
+  return err ? EXIT_FAILURE : EXIT_SUCCESS;
+}
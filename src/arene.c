@@ -0,0 +1,33 @@
+#include "arene.h"
+
+// Macro pour l'alignement des espaces réservés dans l'arène
+#define ALIGNEMENT 8
+
+/**
+ * @brief Implémentation de la fonction initArene.
+ */
+void initArene(Arene *arene, void *memoire, size_t taille) {
+  arene->memoire = (uint8_t *)memoire;
+  arene->taille = taille;
+  arene->utilisee = 0;
+}
+
+/**
+ * @brief Implémentation de la fonction alloueArene.
+ */
+void *alloueArene(Arene *arene, size_t taille) {
+  // On aligne l'adresse du début de l'espace
+  uintptr_t adresse = (uintptr_t)(arene->memoire + arene->utilisee);
+  size_t debut = arene->utilisee + (-adresse & (ALIGNEMENT - 1));
+  if (debut > arene->taille || taille > arene->taille - debut)
+    return NULL;
+  arene->utilisee = debut + taille;
+  return arene->memoire + debut;
+}
+
+/**
+ * @brief Implémentation de la fonction videArene.
+ */
+void videArene(Arene *arene) {
+  arene->utilisee = 0;
+}
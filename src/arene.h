@@ -0,0 +1,36 @@
+#ifndef ARENE_H
+#define ARENE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Structure d'une arène : un bloc de mémoire fourni par l'appelant que l'on découpe au fur et à
+// mesure et que l'on vide d'un coup
+typedef struct arene {
+  uint8_t *memoire;
+  size_t taille, utilisee;
+} Arene;
+
+/**
+ * @brief Initialise une arène sur un bloc de mémoire. L'arène ne libère jamais ce bloc.
+ * @param arene représente l'arène à initialiser. (Paramètre modifié)
+ * @param memoire représente le bloc de mémoire.
+ * @param taille représente la taille du bloc en octets.
+ */
+void initArene(Arene *arene, void *memoire, size_t taille);
+
+/**
+ * @brief Réserve un espace aligné sur 8 octets dans l'arène.
+ * @param arene représente l'arène. (Paramètre modifié)
+ * @param taille représente la taille de l'espace en octets.
+ * @return un pointeur vers l'espace ou NULL si l'arène est pleine.
+ */
+void *alloueArene(Arene *arene, size_t taille);
+
+/**
+ * @brief Vide l'arène : tous les espaces réservés sont rendus d'un coup.
+ * @param arene représente l'arène. (Paramètre modifié)
+ */
+void videArene(Arene *arene);
+
+#endif
@@ -0,0 +1,205 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "modele.h"
+#include "ordonnanceur.h"
+#include "politique.h"
+
+// Structure du résultat d'une partie (echec vaut 1 si elle n'a pas pu être jouée)
+typedef struct {
+  uint32_t score, lignes, pieces;
+  uint8_t echec;
+} Resultat;
+
+// Structure des paramètres communs à toutes les parties
+typedef struct {
+  uint16_t nbLignes, nbColonnes;
+  uint32_t maxPieces;
+  uint64_t graine;
+  const Politique *politique;
+  Resultat *resultats;
+} Batch;
+
+/**
+ * @brief Joue une partie complète sans affichage avec la politique choisie. La partie i utilise la
+ * graine graine + i, les résultats ne dépendent donc pas de l'ordonnancement.
+ * @param indice représente le numéro de la partie.
+ * @param ouvrier représente le numéro de l'ouvrier qui la joue.
+ * @param arg représente les paramètres du batch.
+ */
+static void jouePartie(uint32_t indice, uint16_t ouvrier, void *arg) {
+  Batch *b = (Batch *)arg;
+  Resultat *res = &b->resultats[indice];
+  void *etat = NULL;
+  Modele *modele = initModele(b->nbLignes, b->nbColonnes, b->graine + indice);
+  if (!modele) {
+    fprintf(stderr, "Erreur à la partie %u : Création du modèle échouée\n", indice);
+    res->echec = 1;
+    return;
+  }
+  if (b->politique->creeEtat && !(etat = b->politique->creeEtat(modele, ~(b->graine + indice)))) {
+    fprintf(stderr, "Erreur à la partie %u : Création de l'état de la politique échouée\n", indice);
+    detruitModele(modele);
+    res->echec = 1;
+    return;
+  }
+  // On joue jusqu'à la fin de la partie ou jusqu'au nombre maximum de pièces
+  while (!estTermine(modele) && (!b->maxPieces || res->pieces < b->maxPieces)) {
+    b->politique->joue(modele, etat);
+    res->pieces++;
+    res->lignes += __builtin_popcountll(getLignesSupprimees(modele));
+  }
+  res->score = getScore(modele);
+  if (b->politique->detruitEtat)
+    b->politique->detruitEtat(etat);
+  detruitModele(modele);
+}
+
+/**
+ * @brief Fonction de comparaison de deux entiers non signés pour qsort.
+ */
+static int compare(const void *a, const void *b) {
+  uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+  return (x > y) - (x < y);
+}
+
+/**
+ * @brief Affiche les statistiques agrégées des parties jouées (celles en échec sont comptées à
+ * part).
+ * @param b représente les paramètres du batch contenant les résultats.
+ * @param nbParties représente le nombre de parties lancées.
+ * @param secondes représente la durée totale du batch.
+ * @return le nombre de parties en échec.
+ */
+static uint32_t afficheStatistiques(Batch *b, uint32_t nbParties, double secondes) {
+  uint64_t score = 0, lignes = 0, pieces = 0;
+  uint32_t echecs = 0;
+  uint32_t *scores = (uint32_t *)malloc(nbParties * sizeof(uint32_t));
+  if (!scores) {
+    perror("Erreur à l'affichage des statistiques : Allocation mémoire échouée");
+    return nbParties;
+  }
+  for (uint32_t i = 0; i < nbParties; i++) {
+    if (b->resultats[i].echec) {
+      echecs++;
+      continue;
+    }
+    score += scores[i - echecs] = b->resultats[i].score;
+    lignes += b->resultats[i].lignes;
+    pieces += b->resultats[i].pieces;
+  }
+  nbParties -= echecs;
+  if (echecs)
+    printf("Échecs   : %u parties n'ont pas pu être jouées\n", echecs);
+  if (!nbParties) {
+    free(scores);
+    return echecs;
+  }
+  qsort(scores, nbParties, sizeof(uint32_t), compare);
+  printf("Parties  : %u (%.3f s)\n", nbParties, secondes);
+  printf("Pièces   : %" PRIu64 " au total, %.1f par partie, %.0f par seconde\n", pieces,
+         (double)pieces / nbParties, pieces / secondes);
+  printf("Lignes   : %" PRIu64 " au total, %.2f par partie\n", lignes, (double)lignes / nbParties);
+  printf("Score    : moyenne %.2f, min %u, p10 %u, p50 %u, p90 %u, p99 %u, max %u\n",
+         (double)score / nbParties, scores[0], scores[nbParties / 10], scores[nbParties / 2],
+         scores[nbParties * 9 / 10], scores[nbParties * 99 / 100], scores[nbParties - 1]);
+  free(scores);
+  return echecs;
+}
+
+/************************ Programme Principale *************************/
+
+int main(int argc, char **argv) {
+  Batch b = {20, 10, 0, time(NULL), NULL, NULL};
+  uint32_t nbParties = 1000, echecs;
+  // Nombre de pièces demandé (-1 pour celui de la politique)
+  int64_t maxPieces = -1;
+  long nbOuvriers = 0;
+  const char *politique = "aleatoire";
+  struct timespec debut, fin;
+  int opt;
+
+  // Lecture des options
+  while ((opt = getopt(argc, argv, "n:t:l:c:p:g:m:")) != -1) {
+    switch (opt) {
+      case 'n' :
+        nbParties = strtoul(optarg, NULL, 10);
+        break;
+      case 't' :
+        nbOuvriers = strtol(optarg, NULL, 10);
+        break;
+      case 'l' :
+        b.nbLignes = atoi(optarg);
+        break;
+      case 'c' :
+        b.nbColonnes = atoi(optarg);
+        break;
+      case 'p' :
+        politique = optarg;
+        break;
+      case 'g' :
+        b.graine = strtoull(optarg, NULL, 10);
+        break;
+      case 'm' :
+        maxPieces = strtoul(optarg, NULL, 10);
+        break;
+      default :
+        fprintf(stderr,
+                "Syntaxe : %s [-n parties] [-t threads] [-l nbLignes] [-c nbColonnes] "
+                "[-p politique] [-g graine] [-m maxPieces]\n",
+                argv[0]);
+        return EXIT_FAILURE;
+    }
+  }
+  b.politique = trouvePolitique(politique);
+  if (!b.politique) {
+    fprintf(stderr, "Politique inconnue : %s\n", politique);
+    return EXIT_FAILURE;
+  }
+  // Sans limite, les parties d'une politique qui a un nombre de pièces par défaut ne finissent pas
+  if (!maxPieces && b.politique->maxPieces) {
+    fprintf(stderr, "La politique %s ne perd presque jamais : -m 0 est refusé (%u par défaut)\n",
+            b.politique->nom, b.politique->maxPieces);
+    return EXIT_FAILURE;
+  }
+  b.maxPieces = maxPieces < 0 ? b.politique->maxPieces : (uint32_t)maxPieces;
+  if (!nbParties || b.nbColonnes < MIN_COLONNES || b.nbLignes < MIN_LIGNES ||
+      b.nbColonnes > MAX_COLONNES || b.nbLignes + BASE > MAX_LIGNES) {
+    fprintf(stderr, "1 <= parties, %d <= nbLignes <= %d et %d <= nbColonnes <= %d\n", MIN_LIGNES,
+            MAX_LIGNES - BASE, MIN_COLONNES, MAX_COLONNES);
+    return EXIT_FAILURE;
+  }
+  if (nbOuvriers < 0 || nbOuvriers > MAX_OUVRIERS) {
+    fprintf(stderr, "0 <= threads <= %d (0 pour un par coeur)\n", MAX_OUVRIERS);
+    return EXIT_FAILURE;
+  }
+
+  // Création des résultats
+  b.resultats = (Resultat *)calloc(nbParties, sizeof(Resultat));
+  if (!b.resultats) {
+    perror("Erreur à la création des résultats : Allocation mémoire échouée");
+    return EXIT_FAILURE;
+  }
+
+  // On joue toutes les parties
+  printf("Graine   : %" PRIu64 ", politique %s, terrain %ux%u, %u threads", b.graine,
+         b.politique->nom, b.nbLignes, b.nbColonnes,
+         nbOuvriers ? (uint16_t)nbOuvriers : getNbCoeurs());
+  if (b.maxPieces)
+    printf(", %u pièces au plus", b.maxPieces);
+  printf("\n");
+  clock_gettime(CLOCK_MONOTONIC, &debut);
+  if (executeEnParallele(nbParties, nbOuvriers, jouePartie, &b)) {
+    free(b.resultats);
+    return EXIT_FAILURE;
+  }
+  clock_gettime(CLOCK_MONOTONIC, &fin);
+  echecs = afficheStatistiques(&b, nbParties,
+                               (fin.tv_sec - debut.tv_sec) + (fin.tv_nsec - debut.tv_nsec) / 1e9);
+  free(b.resultats);
+  return echecs ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -1,162 +1,346 @@
+#include <inttypes.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
+#include <unistd.h>
 
-#include "modele.h"
+#include "partie.h"
+#include "rejeu.h"
+#include "tour.h"
 #include "vue.h"
 
-// Macro pour la valeur d'incrémentation du delai
-#define INC_DELAI 75
-// Macro pour le nombre d'iteration de la boucle avant l'avancement de la forme
-#define MAX_APPEL 5
+// Macro pour la durée minimale d'un tour en nanosecondes
+#define PAS_MIN 1000000LL
+// Macro pour le nombre maximum de tours rattrapés d'un coup après un retard
+#define MAX_RATTRAPAGE (2 * MAX_APPEL)
 
 // Structure permettant de controler le jeu
 typedef struct {
-  uint16_t nbAppel, delai, estEnPause, estTermine;
-  Modele *modele;
+  Partie partie;
   Vue *vue;
+  // Rejeu où on enregistre la partie et rejeu que l'on rejoue (NULL si il n'y en a pas)
+  Rejeu *enregistrement, *lecture;
+  // Nombre de formes posées depuis le début de l'enregistrement
+  uint32_t nbPoses;
+  // 1 si on rejoue sans attendre entre les tours et 1 si il n'y a pas d'affichage
+  uint8_t rapide, sansVue;
+  // 1 si on doit quitter le jeu
+  uint8_t aQuitter;
+  // Évènements du joueur depuis le début, publiés avec chaque image pour mesurer leur latence
+  Entrees entreesJoueur;
 } Controleur;
 
 /**
- * @brief Permet de recommencer le jeu
- * @param c représente le controleur du jeu
- * @return 0 si tous s'est bien passée et 1 si non
+ * @brief Permet d'avoir la durée d'un tour : le délai de la partie réparti sur MAX_APPEL tours.
+ * @param c représente le controleur du jeu.
+ * @return la durée d'un tour en nanosecondes (au moins PAS_MIN).
  */
-int8_t recommenceJeu(Controleur *c) {
-  int err;
-  err = recommenceModele(c->modele);
-  c->estEnPause = 0;
-  return err;
+static int64_t getPas(Controleur *c) {
+  int64_t pas = c->partie.delai * 1000000LL / MAX_APPEL;
+  return pas > PAS_MIN ? pas : PAS_MIN;
 }
 
 /**
- * @brief Fait l'action correspondant à l'évènement en paramètre.
+ * @brief Vérifie si on rejoue en accéléré, c'est à dire sans attendre entre les tours.
  * @param c représente le controleur du jeu.
- * @param evt représente l'évènement dont on va faire l'action.
- * @return 0 si tous s'est bien passée et -1 si non.
+ * @return 1 si c'est le cas et 0 si non.
  */
-int8_t action(Controleur *c, Evenement evt) {
-  if (c->estEnPause || c->estTermine) {
-    switch (evt) {
-      case ENTREE :
-        c->estEnPause = 0;
-        return 0;
-      case TOUCHE_R :
-        return recommenceJeu(c);
-      default :
-        return 0;
+static uint8_t estAccelere(Controleur *c) {
+  return c->rapide && c->lecture && !estFiniRejeu(c->lecture);
+}
+
+/**
+ * @brief Vérifie si le jeu est au repos : en pause ou fini, avec un affichage et sans rejeu en
+ * cours. Rien ne bouge alors avant un évènement de la vue.
+ * @param c représente le controleur du jeu.
+ * @return 1 si c'est le cas et 0 si non.
+ */
+static uint8_t estAuRepos(Controleur *c) {
+  return !c->sansVue && (c->partie.estEnPause || c->partie.estTermine) &&
+         (!c->lecture || estFiniRejeu(c->lecture));
+}
+
+/**
+ * @brief Quitte le jeu en enregistrant ECHAP, seul, pour marquer la fin de la partie.
+ * @param c représente le controleur du jeu. (Paramètre modifié)
+ */
+static void quitte(Controleur *c) {
+  if (c->enregistrement)
+    ecritEvenement(c->enregistrement, c->partie.tour, ECHAP);
+  c->aQuitter = 1;
+}
+
+/**
+ * @brief Enregistre les évènements au tour en cours si la partie est enregistrée.
+ * @param c représente le controleur du jeu. (Paramètre modifié)
+ * @param evts représente les évènements.
+ * @param nb représente le nombre d'évènements.
+ * @return 0 si tous s'est bien passée et -1 si non (on doit alors quitter).
+ */
+static int8_t enregistre(Controleur *c, const Evenement *evts, uint16_t nb) {
+  for (uint16_t i = 0; i < nb; i++)
+    if (c->enregistrement && ecritEvenement(c->enregistrement, c->partie.tour, evts[i])) {
+      c->aQuitter = 1;
+      return -1;
     }
+  return 0;
+}
+
+/**
+ * @brief Joue les évènements de la vue dès leur arrivée, sans attendre le tour : ils sont
+ * enregistrés au tour en cours, que le rejeu commence par eux. Pendant un rejeu, seul ECHAP est
+ * écouté.
+ * @param c représente le controleur du jeu. (Paramètre modifié)
+ * @param entrees représente les évènements de la vue.
+ * @param nbEntrees représente le nombre d'évènements de la vue.
+ * @return 1 si la forme est tombée, 0 si tous s'est bien passée et -1 si non.
+ */
+static int8_t joueEntrees(Controleur *c, const EvenementDate *entrees, uint16_t nbEntrees) {
+  Evenement evts[MAX_EVENEMENTS];
+  uint16_t nb;
+  int8_t errEtColl;
+  for (nb = 0; nb < nbEntrees && entrees[nb].evt != ECHAP; nb++)
+    evts[nb] = entrees[nb].evt;
+  if (nb < nbEntrees) {
+    quitte(c);
+    return 0;
   }
-  switch (evt) {
-    case FHAUT :
-      if (c->delai + INC_DELAI <= getDelai(c->modele))
-        c->delai += INC_DELAI;
-      return 0;
-    case FBAS :
-      if (c->delai - INC_DELAI >= 0)
-        c->delai -= INC_DELAI;
-      return 0;
-    case FGAUCHE :
-      formeDecaleGauche(c->modele);
-      return 0;
-    case FDROITE :
-      formeDecaleDroite(c->modele);
-      return 0;
-    case ESPACE :
-      formeTourne(c->modele);
-      return 0;
-    case ENTREE :
-      c->estEnPause = 1;
-      return 0;
-    default :
+  if ((c->lecture && !estFiniRejeu(c->lecture)) || enregistre(c, evts, nb))
+    return 0;
+  if ((errEtColl = joueEvenements(&c->partie, evts, nb)) == -1)
+    c->aQuitter = 1;
+  return errEtColl;
+}
+
+/**
+ * @brief Joue un tour avec les évènements du rejeu si il n'est pas fini : on les enregistre puis
+ * on joue le tour (les évènements de la vue ont déjà été joués par joueEntrees).
+ * @param c représente le controleur du jeu. (Paramètre modifié)
+ * @return 1 si la forme est tombée, 0 si tous s'est bien passée et -1 si non.
+ */
+static int8_t joueTourControleur(Controleur *c) {
+  Evenement evts[MAX_EVENEMENTS];
+  uint16_t nb = 0, i;
+  int8_t errEtColl;
+  if (c->lecture) {
+    if (!estFiniRejeu(c->lecture)) {
+      nb = lisEvenements(c->lecture, c->partie.tour, evts, MAX_EVENEMENTS);
+      // À la fin du rejeu (ECHAP), le joueur continue
+      for (i = 0; i < nb && evts[i] != ECHAP; i++)
+        ;
+      nb = i;
+    }
+    // Sans affichage, on quitte à la fin du rejeu
+    if (c->sansVue && estFiniRejeu(c->lecture)) {
+      quitte(c);
       return 0;
+    }
   }
+  if (enregistre(c, evts, nb))
+    return -1;
+
+  // On joue le tour puis on prend un instantané tous les POSES_PAR_INSTANTANE formes posées
+  errEtColl = joueTour(&c->partie, evts, nb);
+  if (errEtColl == 1 && c->enregistrement && !(++c->nbPoses % POSES_PAR_INSTANTANE) &&
+      ecritInstantane(c->enregistrement, &c->partie))
+    errEtColl = -1;
+  if (errEtColl == -1)
+    c->aQuitter = 1;
+  return errEtColl;
 }
 
 /**
- * @brief Permet de jouer au jeu tetris.
+ * @brief Note les évènements du joueur, ils seront publiés avec la prochaine image.
+ * @param c représente le controleur du jeu. (Paramètre modifié)
+ * @param entrees représente les évènements de la vue.
+ * @param nbEntrees représente le nombre d'évènements de la vue.
+ */
+static void noteEntrees(Controleur *c, const EvenementDate *entrees, uint16_t nbEntrees) {
+  Entrees *e = &c->entreesJoueur;
+  // Si tous les évènements d'avant sont affichés, le plus ancien pas encore affiché est l'un de
+  // ceux-ci (le compte de l'affichage peut être en retard, la latence maximale est alors majorée)
+  uint8_t tousAffiches = getNbEntreesAffichees(c->vue) >= e->nb;
+  for (uint16_t i = 0; i < nbEntrees; i++) {
+    if ((tousAffiches && !i) || entrees[i].date < e->plusAncienne)
+      e->plusAncienne = entrees[i].date;
+    e->nb++, e->sommeDates += entrees[i].date;
+  }
+}
+
+/**
+ * @brief Permet de jouer au jeu tetris. Les tours sont joués à pas fixe sur l'horloge monotone :
+ * le temps écoulé s'accumule et on joue un tour à chaque pas accumulé. Entre deux tours, on bloque
+ * dans la vue jusqu'à l'heure du tour suivant ou jusqu'à un évènement, qui est alors joué tout de
+ * suite. Au repos (en pause ou fini), on bloque sans limite : rien ne tourne avant un évènement.
+ * Les images sont dessinées par le thread d'affichage, le jeu ne dépend donc pas de sa vitesse.
  * @param c représente le controleur du jeu.
  */
 void jouer(Controleur *c) {
-  struct timespec delai;
-  Evenement evt;
-  int8_t errEtColl;
+  EvenementDate entrees[MAX_EVENEMENTS];
+  int64_t precedent = getDate(), present, accumulateur = 0, pas;
+  int8_t errEtColl = 0, collAffichee = 0;
+  uint8_t aAfficher, nb, auRepos = 0;
+  uint16_t nbEntrees;
 
-  // On lit le prochain évènement et le traite
-  evt = c->vue->ecoute();
-  errEtColl = action(c, evt);
-
-  // Si le jeu n'est pas terminée ou en pause et que on a appelé MAX_APPEL fois la fonction
-  c->estTermine = estTermine(c->modele);
-  if (!c->estTermine && !c->estEnPause && c->nbAppel >= MAX_APPEL) {
-    // On fait avancer la forme
-    errEtColl = formeAvance(c->modele);
-    // On reinitialise le delai si il y'a eu collision
-    if (errEtColl == 1)
-      c->delai = getDelai(c->modele);
-  }
+  while (!c->aQuitter) {
+    // On attend l'heure du prochain tour ou un évènement, sauf en rejeu accéléré
+    pas = getPas(c);
+    if (estAccelere(c))
+      accumulateur = pas;
+    else if (accumulateur < pas)
+      c->vue->attends(c->vue, auRepos ? -1 : precedent + pas - accumulateur);
+    present = getDate();
+    // Le temps passé au repos ne compte pas
+    if (auRepos)
+      accumulateur = 0;
+    else if (!estAccelere(c))
+      accumulateur += present - precedent;
+    precedent = present;
 
-  // On met à jour la vue
-  if (c->nbAppel >= MAX_APPEL) {
-    c->vue->metVueAJour(c->vue, c->modele, errEtColl, c->estEnPause, c->estTermine);
-    c->nbAppel = 0;
-  }
+    // On joue tout de suite les évènements de la vue, ceux du joueur sont affichés sans attendre
+    aAfficher = 0;
+    if ((nbEntrees = c->vue->ecoute(c->vue, entrees, MAX_EVENEMENTS))) {
+      errEtColl = joueEntrees(c, entrees, nbEntrees);
+      auRepos = 0;
+      if (!c->lecture || estFiniRejeu(c->lecture))
+        noteEntrees(c, entrees, nbEntrees), aAfficher = 1, collAffichee = errEtColl;
+    }
 
-  // Si on ne quitte pas le jeu, on attend le delai puis on continue
-  if (evt != ECHAP && errEtColl != -1) {
-    delai.tv_sec = 0, delai.tv_nsec = (c->delai / MAX_APPEL) * 1000000;
-    nanosleep(&delai, NULL);
-    c->nbAppel++, jouer(c);
+    // On joue un tour par pas accumulé
+    for (nb = 0; !c->aQuitter && accumulateur >= pas && nb < MAX_RATTRAPAGE; nb++) {
+      errEtColl = joueTourControleur(c);
+      accumulateur -= pas;
+      // On affiche aussi avant de se mettre au repos, la vue ne bouge plus ensuite
+      auRepos = estAuRepos(c);
+      if (c->partie.aAfficher || auRepos)
+        aAfficher = 1, collAffichee = errEtColl;
+      pas = getPas(c);
+    }
+    // Après un trop grand retard (programme suspendu par exemple), on ne rattrape pas tout
+    if (accumulateur >= pas)
+      accumulateur = 0;
+
+    // On publie l'image pour le thread d'affichage, sans attendre qu'elle soit dessinée
+    if (aAfficher && !c->aQuitter)
+      publieImage(c->vue, c->partie.modele, collAffichee, c->partie.estEnPause,
+                  c->partie.estTermine, &c->entreesJoueur);
   }
 }
 
 /************************ Programme Principale *************************/
 
 int main(int argc, char **argv) {
-  srand(time(NULL));
-  Controleur c;
+  Controleur c = {0};
+  Latences latences;
+  int64_t debut;
+  char *fichierEnregistrement = NULL, *fichierLecture = NULL;
   uint16_t nbLignes, nbColonnes;
+  uint64_t graine;
+  uint32_t tour = 0;
+  uint8_t avecIA, aChercher = 0, erreur = 0;
+  double duree;
+  int opt, n;
 
   // Vérification des paramètres
-  if (argc != 4) {
-    fprintf(
-        stderr,
-        "Erreur lors du parsing des paramètres\nSyntaxe : %s {sdl, ncurses} nbLignes nbColonnes",
-        argv[0]);
+  while ((opt = getopt(argc, argv, "e:r:s:x")) != -1) {
+    switch (opt) {
+      case 'e' :
+        fichierEnregistrement = optarg;
+        break;
+      case 'r' :
+        fichierLecture = optarg;
+        break;
+      case 's' :
+        tour = strtoul(optarg, NULL, 10), aChercher = 1;
+        break;
+      case 'x' :
+        c.rapide = 1;
+        break;
+      default :
+        erreur = 1;
+    }
+  }
+  n = argc - optind;
+  c.sansVue = n >= 1 && !strcmp(argv[optind], "aucune");
+  if (erreur || n < 1 || (fichierLecture && (n != 1 || fichierEnregistrement)) ||
+      (!fichierLecture && ((n != 3 && n != 4) || (n == 4 && strcmp(argv[optind + 3], "ia")) ||
+                           c.sansVue || aChercher))) {
+    fprintf(stderr,
+            "Erreur lors du parsing des paramètres\nSyntaxe : %s [-e fichier] {sdl, ncurses} "
+            "nbLignes nbColonnes [ia]\n       %s -r fichier [-s tour] [-x] "
+            "{sdl, ncurses, aucune}\n",
+            argv[0], argv[0]);
     return EXIT_FAILURE;
   }
+  c.rapide |= c.sansVue;
 
-  // Initialisation du nombre de lignes et colonnes
-  nbLignes = atoi(argv[2]);
-  nbColonnes = atoi(argv[3]);
-  if (!(10 <= nbLignes && nbLignes <= 25 && 5 <= nbColonnes && nbColonnes <= 40)) {
+  // Initialisation du nombre de lignes et colonnes, de la graine et de l'IA (depuis le rejeu)
+  if (fichierLecture) {
+    c.lecture = ouvreRejeu(fichierLecture);
+    if (!c.lecture)
+      return EXIT_FAILURE;
+    nbLignes = c.lecture->nbLignes, nbColonnes = c.lecture->nbColonnes;
+    graine = c.lecture->graine, avecIA = c.lecture->avecIA;
+  } else {
+    nbLignes = atoi(argv[optind + 1]);
+    nbColonnes = atoi(argv[optind + 2]);
+    graine = time(NULL), avecIA = n == 4;
+  }
+  if (!c.sansVue && !(10 <= nbLignes && nbLignes <= 25 && 5 <= nbColonnes && nbColonnes <= 40)) {
     fprintf(stderr, "10 <= nbLignes <= 25 et 5 <= nbColonnes <= 40\nPour une bonne affichage\n");
+    fermeRejeu(c.lecture);
+    return EXIT_FAILURE;
+  }
+
+  // Initialisation de la partie
+  if (initPartie(&c.partie, nbLignes, nbColonnes, graine, avecIA)) {
+    fermeRejeu(c.lecture);
     return EXIT_FAILURE;
   }
 
-  // Initialisation du modèle du jeu.
-  c.modele = initModele(nbLignes, nbColonnes);
-  if (!c.modele)
+  // Création du rejeu où on enregistre la partie (avec l'instantané du début) ou recherche du tour
+  // dans le rejeu que l'on rejoue
+  if (fichierEnregistrement)
+    c.enregistrement = creeRejeu(fichierEnregistrement, nbLignes, nbColonnes, graine, avecIA);
+  if ((fichierEnregistrement &&
+       (!c.enregistrement || ecritInstantane(c.enregistrement, &c.partie))) ||
+      (aChercher && chercheRejeu(c.lecture, &c.partie, tour))) {
+    fermeRejeu(c.enregistrement);
+    fermeRejeu(c.lecture);
+    detruitPartie(&c.partie);
     return EXIT_FAILURE;
+  }
 
   // Initialisation de la vue du jeu.
-  c.vue = initVue(argv[1], nbLignes, nbColonnes);
+  c.vue = initVue(argv[optind], nbLignes, nbColonnes);
   if (!c.vue) {
-    detruitModele(c.modele);
+    fermeRejeu(c.enregistrement);
+    fermeRejeu(c.lecture);
+    detruitPartie(&c.partie);
     return EXIT_FAILURE;
   }
 
-  // Initialisation du reste des variables
-  c.delai = getDelai(c.modele);
-  c.estEnPause = 1;
-  c.nbAppel = c.estTermine = 0;
-
   // On joue au jeu
+  debut = getDate();
   jouer(&c);
+  duree = (getDate() - debut) / 1e9;
 
-  // Destruction du jeu
-  detruitModele(c.modele);
   // Destruction de la vue
-  c.vue->detruitVue(c.vue);
+  fermeVue(c.vue, &latences);
+  // On donne la latence entre les évènements du joueur et leur affichage
+  if (latences.nb)
+    printf("Latence : %" PRIu64 " évènements, moyenne %.2f ms, max %.2f ms\n", latences.nb,
+           latences.somme / 1e6 / latences.nb, latences.max / 1e6);
+  // Sans affichage, on donne le résultat du rejeu
+  if (c.sansVue) {
+    printf("tours %u score %u empreinte %016llx duree %.3fs (%.0f tours/s)\n", c.partie.tour,
+           getScore(c.partie.modele), (unsigned long long)getEmpreinte(c.partie.modele), duree,
+           duree > 0 ? c.partie.tour / duree : 0);
+  }
+  // Destruction du jeu
+  fermeRejeu(c.enregistrement);
+  fermeRejeu(c.lecture);
+  detruitPartie(&c.partie);
   return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
@@ -0,0 +1,22 @@
+#ifndef EVENEMENT_H
+#define EVENEMENT_H
+
+// Macro pour le nombre maximum d'évènements d'un tour
+#define MAX_EVENEMENTS 32
+
+// Énumération des actions du joueur sur la partie, celles que les rejeux enregistrent (chacune
+// porte le nom de la touche qui la déclenche dans les vues)
+typedef enum evenement {
+  ECHAP = 0,
+  ESPACE,
+  ENTREE,
+  FGAUCHE,
+  FHAUT,
+  FDROITE,
+  FBAS,
+  TOUCHE_R,
+  TOUCHE_C,
+  RIEN
+} Evenement;
+
+#endif
@@ -5,51 +5,90 @@
 #include "forme.h"
 
 // Énumération de toutes les formes dans une variable globale
-static const Couple LES_FORMES[7][4] = {
+static const Couple LES_FORMES[NB_FORMES][NB_CASES_FORME] = {
     {{-1, 1}, {-1, 0}, {0, 0}, {1, 0}}, {{-1, 0}, {0, 0}, {0, 1}, {1, 1}},
     {{-1, 1}, {0, 1}, {0, 0}, {1, 0}},  {{-1, 0}, {0, 0}, {1, 0}, {1, 1}},
     {{-1, 1}, {0, 1}, {0, 0}, {1, 1}},  {{0, 0}, {1, 0}, {1, 1}, {0, 1}},
     {{0, 0}, {0, 1}, {0, 2}, {0, 3}}};
 
+// Table de tous les états de rotation des formes, construite au lancement du programme
+static Rotation LES_ROTATIONS[NB_FORMES][NB_ROTATIONS];
+
 /**
- * @brief Implementation de la fonction initForme.
+ * @brief Construit la table des rotations en tournant les formes de LES_FORMES d'un angle de 90°
+ * dans le sens des aiguilles d'une montre. Elle est appelée avant la fonction main.
  */
-Forme *initForme(Modele *modele) {
-  // Création de la forme et gestion d'erreur
-  Forme *forme = (Forme *)malloc(sizeof(Forme));
-  if (!forme) {
-    perror("Erreur à la création de la forme : Allocation mémoire échouée");
-    return NULL;
-  }
-  // Initialisation de la couleur
-  forme->couleur = 1 + rand() % 7;
-  // Initialisation des coordonnées d'origine
-  forme->x0 = rand() % (modele->nbColonnes - 2) + 1;
-  forme->y0 = 0;
-  // Initialisation du modele
-  forme->modele = modele;
-
-  // Initialisation de la forme choisie et gestion d'erreur
-  forme->forme = (Couple *)malloc(NB_CASES_FORME * sizeof(Couple));
-  if (!forme->forme) {
-    free(forme);
-    perror("Erreur à la création de la forme : Allocation mémoire échouée");
-    return NULL;
-  }
-  memcpy(forme->forme, LES_FORMES[rand() % 7], NB_CASES_FORME * sizeof(Couple));
-  return forme;
+__attribute__((constructor)) static void construitRotations(void) {
+  Rotation *r;
+  Couple c;
+  for (int i = 0; i < NB_FORMES; i++)
+    for (int j = 0; j < NB_ROTATIONS; j++) {
+      r = &LES_ROTATIONS[i][j];
+      // On tourne l'état précédent (ou on part de la forme de base)
+      for (int k = 0; k < NB_CASES_FORME; k++) {
+        c = j ? LES_ROTATIONS[i][j - 1].cases[k] : LES_FORMES[i][k];
+        r->cases[k] = j ? (Couple){-1 * c.y, c.x} : c;
+      }
+      // On calcule la boîte englobante
+      r->xMin = r->yMin = INT16_MAX;
+      int16_t xMax = INT16_MIN, yMax = INT16_MIN;
+      for (int k = 0; k < NB_CASES_FORME; k++) {
+        c = r->cases[k];
+        r->xMin = c.x < r->xMin ? c.x : r->xMin, xMax = c.x > xMax ? c.x : xMax;
+        r->yMin = c.y < r->yMin ? c.y : r->yMin, yMax = c.y > yMax ? c.y : yMax;
+      }
+      r->larg = xMax - r->xMin + 1;
+      r->haut = yMax - r->yMin + 1;
+      // On calcule les masques des lignes et le bas des colonnes
+      memset(r->masques, 0, sizeof(r->masques));
+      memset(r->bas, 0, sizeof(r->bas));
+      for (int k = 0; k < NB_CASES_FORME; k++) {
+        c = (Couple){r->cases[k].x - r->xMin, r->cases[k].y - r->yMin};
+        r->masques[c.y] |= 1 << c.x;
+        r->bas[c.x] = c.y > r->bas[c.x] ? c.y : r->bas[c.x];
+      }
+      // On cherche le premier état qui a la même boîte et les mêmes masques
+      for (r->equivalente = 0; r->equivalente < j; r->equivalente++) {
+        Rotation *e = &LES_ROTATIONS[i][r->equivalente];
+        if (e->larg == r->larg && e->haut == r->haut && !memcmp(e->masques, r->masques, 4))
+          break;
+      }
+    }
+}
+
+/**
+ * @brief Implémentation de la fonction getRotation.
+ */
+const Rotation *getRotation(uint8_t id, uint8_t rotation) {
+  return &LES_ROTATIONS[id][rotation];
+}
+
+/**
+ * @brief Implémentation de la fonction positionValide.
+ */
+uint8_t positionValide(Modele *modele, const Rotation *r, int16_t x, int16_t y) {
+  // On vérifie si la forme deborde le terrain
+  if (x < 0 || x + r->larg > getNbColonnes(modele) || y < 0 || y + r->haut > getNbLignes(modele))
+    return 0;
+  // On vérifie si les cases de la forme sont libres
+  for (int i = 0; i < r->haut; i++)
+    if (modele->lignes[y + i] & ((uint64_t)r->masques[i] << x))
+      return 0;
+  return 1;
 }
 
 /**
- * @brief Implémentation de la fonction detruitForme.
+ * @brief Implementation de la fonction initForme.
  */
-void detruitForme(Forme *forme) {
-  if (!forme)
-    return;
-  // Destruction des coordonnées
-  free(forme->forme);
-  // La forme ne detruit pas le modèle
-  free(forme);
+void initForme(Modele *modele, Forme *forme) {
+  // Initialisation de la couleur
+  forme->couleur = 1 + tireAlea(&modele->alea, 7);
+  // Initialisation des coordonnées d'origine
+  forme->x0 = tireAlea(&modele->alea, modele->nbColonnes - 2) + 1;
+  forme->y0 = 0;
+  // Initialisation de la forme choisie
+  forme->id = tireAlea(&modele->alea, NB_FORMES);
+  forme->rotation = 0;
 }
 
 /**
@@ -63,46 +102,62 @@ Couleur getCouleur(Forme *forme) {
  * @brief Implémentation de la fonction getCoordonnees.
  */
 void getCoordonees(Forme *forme, Couple *coords) {
-  memcpy(coords, forme->forme, NB_CASES_FORME * sizeof(Couple));
+  memcpy(coords, getRotation(forme->id, forme->rotation)->cases, NB_CASES_FORME * sizeof(Couple));
 }
 
 /**
  * @brief Implémentation de la fonction getCoordonneesTerrain.
  */
 void getCoordoneesTerrain(Forme *forme, Couple *coords) {
+  const Rotation *r = getRotation(forme->id, forme->rotation);
   for (int i = 0; i < NB_CASES_FORME; i++)
-    coords[i] = (Couple){forme->forme[i].x + forme->x0, forme->forme[i].y + forme->y0};
+    coords[i] = (Couple){r->cases[i].x + forme->x0, r->cases[i].y + forme->y0};
 }
 
 /**
  * @brief Implémentation de la fonction estEnCollision.
  */
-uint8_t estEnCollision(Forme *forme) {
-  Couple c;
-  // On parcours les coordonnées
-  for (int i = 0; i < NB_CASES_FORME; i++) {
-    c = (Couple){forme->forme[i].x + forme->x0, forme->forme[i].y + forme->y0};
-    // On vérifie si la case en dessous deborde ou est occupée
-    if (c.y == getNbLignes(forme->modele) - 1 || estOccupee(forme->modele, c.x, c.y + 1))
+uint8_t estEnCollision(Modele *modele, Forme *forme) {
+  const Rotation *r = getRotation(forme->id, forme->rotation);
+  int16_t x = forme->x0 + r->xMin, y = forme->y0 + r->yMin;
+  // On vérifie si la forme touche la dernière ligne
+  if (y + r->haut >= getNbLignes(modele))
+    return 1;
+  // On vérifie si les lignes en dessous de la forme sont occupées
+  for (int i = 0; i < r->haut; i++)
+    if (modele->lignes[y + i + 1] & ((uint64_t)r->masques[i] << x))
       return 1;
-  }
   return 0;
 }
 
 /**
  * @brief Implémentation de la fonction coordonneesValides
  */
-uint8_t coordonneesValides(Forme *forme) {
-  Couple c;
-  // On parcours les coordonnées
-  for (int i = 0; i < NB_CASES_FORME; i++) {
-    c = (Couple){forme->forme[i].x + forme->x0, forme->forme[i].y + forme->y0};
-    // On vérifie si elles sont valides
-    if (!(0 <= c.y && c.y < getNbLignes(forme->modele) && 0 <= c.x &&
-          c.x < getNbColonnes(forme->modele) && !estOccupee(forme->modele, c.x, c.y)))
-      return 0;
+uint8_t coordonneesValides(Modele *modele, Forme *forme) {
+  const Rotation *r = getRotation(forme->id, forme->rotation);
+  return positionValide(modele, r, forme->x0 + r->xMin, forme->y0 + r->yMin);
+}
+
+/**
+ * @brief Implémentation de la fonction distanceChute.
+ */
+uint16_t distanceChute(Modele *modele, Forme *forme) {
+  const Rotation *r = getRotation(forme->id, forme->rotation);
+  int16_t x = forme->x0 + r->xMin, y = forme->y0 + r->yMin, bas, sommet, dist = INT16_MAX;
+  // On compare le bas de chaque colonne de la forme au sommet de la colonne du terrain
+  for (int i = 0; i < r->larg; i++) {
+    bas = y + r->bas[i];
+    sommet = getNbLignes(modele) - getHauteurColonne(modele, x + i);
+    // Si la forme est sous le sommet (sous un surplomb), on descend ligne par ligne
+    if (bas >= sommet) {
+      for (dist = 0; positionValide(modele, r, x, y + dist + 1); dist++)
+        ;
+      return dist;
+    }
+    if (sommet - bas - 1 < dist)
+      dist = sommet - bas - 1;
   }
-  return 1;
+  return dist;
 }
 
 /**
@@ -112,32 +167,37 @@ void avance(Forme *forme) {
   forme->y0 += 1;
 }
 
+/**
+ * @brief Implémentation de la fonction chute.
+ */
+void chute(Modele *modele, Forme *forme) {
+  forme->y0 += distanceChute(modele, forme);
+}
+
 /**
  * @brief Implémentation de la fonction decaleGauche.
  */
-void decaleGauche(Forme *forme) {
+void decaleGauche(Modele *modele, Forme *forme) {
   forme->x0 -= 1;
-  if (!coordonneesValides(forme))
+  if (!coordonneesValides(modele, forme))
     forme->x0 += 1;
 }
 
 /**
  * @brief Implémentation de la fonction decaleDroite.
  */
-void decaleDroite(Forme *forme) {
+void decaleDroite(Modele *modele, Forme *forme) {
   forme->x0 += 1;
-  if (!coordonneesValides(forme))
+  if (!coordonneesValides(modele, forme))
     forme->x0 -= 1;
 }
 
 /**
  * @brief Implémentation de la fonction tourne.
  */
-void tourne(Forme *forme) {
-  Couple forme_tmp[NB_CASES_FORME];
-  memcpy(forme_tmp, forme->forme, NB_CASES_FORME * sizeof(Couple));
-  for (int i = 0; i < NB_CASES_FORME; i++)
-    forme->forme[i] = (Couple){-1 * forme_tmp[i].y, forme_tmp[i].x};
-  if (!coordonneesValides(forme))
-    memcpy(forme->forme, forme_tmp, NB_CASES_FORME * sizeof(Couple));
+void tourne(Modele *modele, Forme *forme) {
+  uint8_t rotation = forme->rotation;
+  forme->rotation = (rotation + 1) % NB_ROTATIONS;
+  if (!coordonneesValides(modele, forme))
+    forme->rotation = rotation;
 }
\ No newline at end of file
@@ -3,26 +3,49 @@
 
 #include "modele.h"
 
-// Structure d'une forme du jeu Tetris
-struct forme {
-  uint16_t x0, y0;
-  Couleur couleur;
-  Modele *modele;
-  Couple *forme;
-};
+// En-tête interne au moteur : la table des rotations et les opérations sur une forme ne font pas
+// partie de l'en-tête public tetris.h
+
+// Structure d'un état de rotation d'une forme
+typedef struct rotation {
+  // Coordonnées relatives des cases
+  Couple cases[NB_CASES_FORME];
+  // Coin haut gauche et dimensions de la boîte englobante
+  int16_t xMin, yMin;
+  uint8_t larg, haut;
+  // Masque de chaque ligne de la boîte (le bit 0 correspond à la colonne xMin)
+  uint8_t masques[NB_CASES_FORME];
+  // Ligne relative de la plus basse case de chaque colonne de la boîte
+  uint8_t bas[NB_CASES_FORME];
+  // Plus petit état de rotation de la même forme qui occupe les mêmes cases dans sa boîte
+  uint8_t equivalente;
+} Rotation;
 
 /**
- * @brief Crée et initialise une forme.
- * @param modele représente le modèle du jeu Tetris dans lequel sera la forme.
- * @return la nouvelle forme créee (que l'on doit liberer) ou NULL si il y'a erreur.
+ * @brief Permet d'avoir un état de rotation dans la table des rotations construite au lancement.
+ * @param id représente le numéro de la forme.
+ * @param rotation représente le numéro de l'état de rotation.
+ * @return un pointeur vers l'état de rotation.
+ */
+const Rotation *getRotation(uint8_t id, uint8_t rotation);
+
+/**
+ * @brief Vérifie si un état de rotation placé avec sa boîte en (x, y) tient dans le terrain sans
+ * chevaucher de case occupée.
+ * @param modele représente le modèle du jeu.
+ * @param r représente l'état de rotation.
+ * @param x représente la colonne du bord gauche de la boîte.
+ * @param y représente la ligne du haut de la boîte.
+ * @return 1 si la position est valide et 0 si non.
  */
-Forme *initForme(Modele *modele);
+uint8_t positionValide(Modele *modele, const Rotation *r, int16_t x, int16_t y);
 
 /**
- * @brief Détruit et libère l'espace occupée par une forme.
- * @param forme représente la forme à détruire.
+ * @brief Initialise une forme choisie au hasard par le générateur du modèle sans allocation.
+ * @param modele représente le modèle du jeu Tetris dans lequel sera la forme.
+ * @param forme représente l'espace où initialiser la forme. (Paramètre modifié)
  */
-void detruitForme(Forme *forme);
+void initForme(Modele *modele, Forme *forme);
 
 /**
  * @brief Permet d'avoir la couleur de la forme spécifiée.
@@ -48,18 +71,29 @@ void getCoordoneesTerrain(Forme *forme, Couple *coords);
 /**
  * @brief Parcours la forme et vérifie si elle est en collision (Si elle atteint la derinière ligne
  * ou si la case en dessous d'elle est occupé).
+ * @param modele représente le modèle du jeu contenant la forme.
  * @param forme représente la forme dont on va vérifier la collision.
  * @return 1 si elle est en collision et 0 si non.
  */
-uint8_t estEnCollision(Forme *forme);
+uint8_t estEnCollision(Modele *modele, Forme *forme);
 
 /**
  * @brief Vérifie si les coordonnées de la forme sont toutes valides c'est à dire si elles
  * debordent pas le terrain et qu'elles ne sont pas déjà occupées.
+ * @param modele représente le modèle du jeu contenant la forme.
  * @param forme représente la forme dont on va vérifier les coordonnées.
  * @return 1 si elles sont valides et 0 si non.
  */
-uint8_t coordonneesValides(Forme *forme);
+uint8_t coordonneesValides(Modele *modele, Forme *forme);
+
+/**
+ * @brief Calcule le nombre de cases dont la forme peut descendre avant d'être en collision. Il se
+ * sert de la hauteur des colonnes et ne parcours les lignes que si la forme est sous un surplomb.
+ * @param modele représente le modèle du jeu contenant la forme.
+ * @param forme représente la forme dont on veut la distance de chute.
+ * @return le nombre de cases libres sous la forme.
+ */
+uint16_t distanceChute(Modele *modele, Forme *forme);
 
 /**
  * @brief Fait avancer la forme d'une case vers le bas.
@@ -67,22 +101,32 @@ uint8_t coordonneesValides(Forme *forme);
  */
 void avance(Forme *forme);
 
+/**
+ * @brief Fait tomber la forme d'un coup jusqu'à ce qu'elle soit en collision.
+ * @param modele représente le modèle du jeu contenant la forme.
+ * @param forme représente la forme dont on va faire tomber. (Paramètre modifié)
+ */
+void chute(Modele *modele, Forme *forme);
+
 /**
  * @brief Décale la forme d'une case vers la gauche.
+ * @param modele représente le modèle du jeu contenant la forme.
  * @param forme représente la forme dont on va decaler vers la gauche. (Paramètre modifié)
  */
-void decaleGauche(Forme *forme);
+void decaleGauche(Modele *modele, Forme *forme);
 
 /**
  * @brief Décale la forme d'une case vers la droite.
+ * @param modele représente le modèle du jeu contenant la forme.
  * @param forme représente la forme dont on va decaler vers la droite. (Paramètre modifié)
  */
-void decaleDroite(Forme *forme);
+void decaleDroite(Modele *modele, Forme *forme);
 
 /**
  * @brief Tourne la forme d'un angle de 90° dans le sens des aiguilles d'une montre.
+ * @param modele représente le modèle du jeu contenant la forme.
  * @param forme représente la forme dont on decale vers la droite. (Paramètre modifié)
  */
-void tourne(Forme *forme);
+void tourne(Modele *modele, Forme *forme);
 
 #endif
\ No newline at end of file
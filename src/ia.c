@@ -0,0 +1,207 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ia.h"
+
+// Macro pour le nombre de formes connues sur lesquelles on cherche (la courante et la suivante)
+#define PROFONDEUR 2
+// Macro pour le nombre d'entrées de la table de transposition (une puissance de 2)
+#define TAILLE_TABLE (1 << 15)
+// Macro pour la valeur d'un terrain où la partie est terminée
+#define VALEUR_PERDUE (INT32_MIN / 2)
+
+// Structure d'un terrain du faisceau : les placements qui y mènent depuis la racine et le nombre de
+// lignes qu'ils ont supprimées
+typedef struct noeud {
+  Placement chemin[PROFONDEUR];
+  uint16_t lignes;
+} Noeud;
+
+// Structure d'un terrain candidat pour le niveau suivant du faisceau
+typedef struct candidat {
+  uint64_t cle;
+  int32_t valeur;
+  uint16_t parent, lignes;
+  Placement placement;
+} Candidat;
+
+// Structure d'une entrée de la table de transposition
+typedef struct entree {
+  uint64_t cle;
+  uint32_t generation;
+  uint32_t candidat;
+} Entree;
+
+// Structure de l'IA
+struct ia {
+  uint16_t largeur;
+  // Terrains du faisceau courant et du suivant
+  Noeud *noeuds, *faisceau, *suivants;
+  // Candidats du niveau en cours
+  Candidat *candidats;
+  // Table de transposition (une entrée n'est valide que pour la génération courante)
+  Entree *table;
+  uint32_t generation;
+};
+
+/**
+ * @brief Évalue un terrain : on pénalise la hauteur totale, les trous et les différences de hauteur
+ * entre colonnes voisines et on récompense les lignes supprimées.
+ * @param modele représente le modèle du jeu.
+ * @param lignes représente le nombre de lignes supprimées pour arriver à ce terrain.
+ * @return la valeur du terrain (plus elle est grande, meilleur il est).
+ */
+static int32_t evalue(Modele *modele, uint16_t lignes) {
+  int32_t hauteur = 0, bosses = 0;
+  if (estTermine(modele))
+    return VALEUR_PERDUE;
+  for (int x = 0; x < getNbColonnes(modele); x++) {
+    hauteur += getHauteurColonne(modele, x);
+    if (x > 0)
+      bosses += abs(getHauteurColonne(modele, x) - getHauteurColonne(modele, x - 1));
+  }
+  return -510 * hauteur + 761 * lignes - 357 * getNbTrous(modele) - 184 * bosses;
+}
+
+/**
+ * @brief Joue les placements d'un chemin depuis la racine en notant leurs dépôts.
+ * @param modele représente le modèle du jeu. (Paramètre modifié)
+ * @param chemin représente les placements à jouer.
+ * @param n représente le nombre de placements.
+ * @param depots représente l'espace où noter les dépôts. (Paramètre modifié)
+ */
+static void joueChemin(Modele *modele, const Placement *chemin, int n, Depot *depots) {
+  for (int i = 0; i < n; i++)
+    joueDepot(modele, chemin[i].rotation, chemin[i].x0, chemin[i].y0, &depots[i]);
+}
+
+/**
+ * @brief Annule les dépôts d'un chemin du dernier au premier.
+ * @param modele représente le modèle du jeu. (Paramètre modifié)
+ * @param n représente le nombre de placements du chemin.
+ * @param depots représente les dépôts du chemin.
+ */
+static void annuleChemin(Modele *modele, int n, const Depot *depots) {
+  for (int i = n - 1; i >= 0; i--)
+    annuleDepot(modele, &depots[i]);
+}
+
+/**
+ * @brief Compare deux candidats pour les trier du meilleur au moins bon.
+ */
+static int compareCandidats(const void *a, const void *b) {
+  int32_t va = ((const Candidat *)a)->valeur, vb = ((const Candidat *)b)->valeur;
+  return (va < vb) - (va > vb);
+}
+
+/**
+ * @brief Implémentation de la fonction initIA.
+ */
+IA *initIA(uint16_t largeur) {
+  // Création de l'IA
+  IA *ia = (IA *)calloc(1, sizeof(IA));
+  if (!ia) {
+    perror("Erreur à la création de l'IA : Allocation mémoire échouée");
+    return NULL;
+  }
+  ia->largeur = largeur ? largeur : 1;
+  // Création des faisceaux, des candidats et de la table de transposition
+  ia->noeuds = (Noeud *)malloc(2 * ia->largeur * sizeof(Noeud));
+  ia->candidats = (Candidat *)malloc(ia->largeur * MAX_PLACEMENTS * sizeof(Candidat));
+  ia->table = (Entree *)calloc(TAILLE_TABLE, sizeof(Entree));
+  if (!ia->noeuds || !ia->candidats || !ia->table) {
+    perror("Erreur à la création de l'IA : Allocation mémoire échouée");
+    detruitIA(ia);
+    return NULL;
+  }
+  ia->faisceau = ia->noeuds, ia->suivants = ia->noeuds + ia->largeur;
+  return ia;
+}
+
+/**
+ * @brief Implémentation de la fonction detruitIA.
+ */
+void detruitIA(IA *ia) {
+  if (!ia)
+    return;
+  free(ia->noeuds);
+  free(ia->candidats);
+  free(ia->table);
+  free(ia);
+}
+
+/**
+ * @brief Implémentation de la fonction choisitPlacementIA.
+ */
+int8_t choisitPlacementIA(IA *ia, Modele *modele, Placement *placement) {
+  Placement placements[MAX_PLACEMENTS];
+  Depot depots[PROFONDEUR];
+  uint16_t nbFaisceau = 1, nbPlacements, lignes, i, j;
+  uint32_t nbCandidats, h;
+  Candidat *c;
+  Noeud *tmp;
+  int8_t trouve = -1;
+
+  // La racine du faisceau est le modèle lui même
+  ia->faisceau[0].lignes = 0;
+
+  for (int niveau = 0; niveau < PROFONDEUR; niveau++) {
+    // Une nouvelle génération vide la table de transposition
+    ia->generation++;
+    nbCandidats = 0;
+    for (i = 0; i < nbFaisceau; i++) {
+      // On rejoue le chemin du terrain sur le modèle
+      joueChemin(modele, ia->faisceau[i].chemin, niveau, depots);
+      nbPlacements = enumerePlacements(modele, placements, MAX_PLACEMENTS);
+      for (j = 0; j < nbPlacements; j++) {
+        // On essaie le placement puis on l'annule
+        joueDepot(modele, placements[j].rotation, placements[j].x0, placements[j].y0,
+                  &depots[niveau]);
+        lignes = ia->faisceau[i].lignes + __builtin_popcountll(getLignesSupprimees(modele));
+        Candidat nouveau = {getEmpreinte(modele), evalue(modele, lignes), i, lignes,
+                            placements[j]};
+        annuleDepot(modele, &depots[niveau]);
+        // On cherche le terrain dans la table de transposition à partir de son empreinte
+        for (h = nouveau.cle & (TAILLE_TABLE - 1);
+             ia->table[h].generation == ia->generation && ia->table[h].cle != nouveau.cle;
+             h = (h + 1) & (TAILLE_TABLE - 1))
+          ;
+        // Si il a déjà été atteint, on ne garde que le meilleur chemin
+        if (ia->table[h].generation == ia->generation) {
+          c = &ia->candidats[ia->table[h].candidat];
+          if (nouveau.valeur > c->valeur)
+            *c = nouveau;
+          continue;
+        }
+        // Si non on l'ajoute tant que la table n'est pas trop pleine
+        if (nbCandidats >= TAILLE_TABLE / 2)
+          continue;
+        ia->table[h] = (Entree){nouveau.cle, ia->generation, nbCandidats};
+        ia->candidats[nbCandidats++] = nouveau;
+      }
+      // On remet le modèle à la racine
+      annuleChemin(modele, niveau, depots);
+    }
+    if (!nbCandidats)
+      break;
+
+    // On garde les meilleurs candidats dans le faisceau suivant
+    qsort(ia->candidats, nbCandidats, sizeof(Candidat), compareCandidats);
+    c = &ia->candidats[0];
+    *placement = niveau ? ia->faisceau[c->parent].chemin[0] : c->placement;
+    trouve = 0;
+    if (niveau == PROFONDEUR - 1)
+      break;
+    nbFaisceau = nbCandidats < ia->largeur ? nbCandidats : ia->largeur;
+    for (i = 0; i < nbFaisceau; i++) {
+      c = &ia->candidats[i];
+      memcpy(ia->suivants[i].chemin, ia->faisceau[c->parent].chemin, niveau * sizeof(Placement));
+      ia->suivants[i].chemin[niveau] = c->placement;
+      ia->suivants[i].lignes = c->lignes;
+    }
+    // Le faisceau suivant devient le faisceau courant
+    tmp = ia->faisceau, ia->faisceau = ia->suivants, ia->suivants = tmp;
+  }
+  return trouve;
+}
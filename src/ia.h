@@ -0,0 +1,38 @@
+#ifndef IA_H
+#define IA_H
+
+#include "modele.h"
+#include "placement.h"
+
+// Macro pour la largeur par défaut du faisceau (le nombre de terrains gardés à chaque niveau)
+#define LARGEUR_FAISCEAU 16
+
+// Structure de l'IA : ses faisceaux et sa table de transposition
+typedef struct ia IA;
+
+/**
+ * @brief Crée l'IA.
+ * @param largeur représente la largeur du faisceau (LARGEUR_FAISCEAU par défaut).
+ * @return l'IA créée (que l'on doit libérer) ou NULL si il y'a erreur.
+ */
+IA *initIA(uint16_t largeur);
+
+/**
+ * @brief Détruit et libère l'espace occupée par l'IA.
+ * @param ia représente l'IA à détruire.
+ */
+void detruitIA(IA *ia);
+
+/**
+ * @brief Choisit le placement de la forme courante par une recherche en faisceau sur la forme
+ * courante puis la suivante. Les terrains atteints par des suites de placements différentes ne
+ * sont gardés qu'une fois grâce à une table de transposition. Les placements sont essayés sur le
+ * modèle puis annulés, il est donc rendu dans son état de départ et rien n'est alloué.
+ * @param ia représente l'IA. (Paramètre modifié)
+ * @param modele représente le modèle du jeu. (Paramètre modifié puis rétabli)
+ * @param placement représente l'espace où stocker le placement choisi. (Paramètre modifié)
+ * @return 0 si un placement a été choisi et -1 si la forme courante n'en a aucun.
+ */
+int8_t choisitPlacementIA(IA *ia, Modele *modele, Placement *placement);
+
+#endif
@@ -11,13 +11,151 @@
 #define DELAI_MIN 45
 // Macro pour le coefficient d'ajout en fonction du niveau
 #define COEF_DELAI 15
+// Macro pour le décalage des origines des formes dans les tables de clés (elles peuvent être
+// négatives)
+#define DECALAGE_CLE 4
+
+// Clés de Zobrist des cases du terrain, des formes courantes (forme et rotation, abscisse et
+// ordonnée de l'origine) et des formes suivantes (forme et abscisse de l'origine)
+static uint64_t CLES_CASES[MAX_LIGNES][MAX_COLONNES];
+static uint64_t CLES_FORMES[NB_FORMES][NB_ROTATIONS];
+static uint64_t CLES_X[MAX_COLONNES + 2 * DECALAGE_CLE], CLES_Y[MAX_LIGNES + 2 * DECALAGE_CLE];
+static uint64_t CLES_SUIVANTES[NB_FORMES][MAX_COLONNES + 2 * DECALAGE_CLE];
+
+/**
+ * @brief Tire les clés de Zobrist avec un générateur de graine fixe pour que les empreintes soient
+ * les mêmes d'un lancement à l'autre. Elle est appelée avant la fonction main.
+ */
+__attribute__((constructor)) static void tireCles(void) {
+  Alea alea;
+  int i, j;
+  initAlea(&alea, 0x7e7215);
+  for (i = 0; i < MAX_LIGNES; i++)
+    for (j = 0; j < MAX_COLONNES; j++)
+      CLES_CASES[i][j] = suivantAlea(&alea);
+  for (i = 0; i < NB_FORMES; i++)
+    for (j = 0; j < NB_ROTATIONS; j++)
+      CLES_FORMES[i][j] = suivantAlea(&alea);
+  for (i = 0; i < MAX_COLONNES + 2 * DECALAGE_CLE; i++)
+    CLES_X[i] = suivantAlea(&alea);
+  for (i = 0; i < MAX_LIGNES + 2 * DECALAGE_CLE; i++)
+    CLES_Y[i] = suivantAlea(&alea);
+  for (i = 0; i < NB_FORMES; i++)
+    for (j = 0; j < MAX_COLONNES + 2 * DECALAGE_CLE; j++)
+      CLES_SUIVANTES[i][j] = suivantAlea(&alea);
+}
+
+/**
+ * @brief Calcule la clé des formes courante et suivante du modèle.
+ * @param modele représente le modèle du jeu.
+ * @return le ou exclusif des clés des deux formes.
+ */
+static inline uint64_t cleFormes(Modele *modele) {
+  Forme *f = &modele->forme, *s = &modele->suivante;
+  return CLES_FORMES[f->id][f->rotation] ^ CLES_X[f->x0 + DECALAGE_CLE] ^
+         CLES_Y[f->y0 + DECALAGE_CLE] ^ CLES_SUIVANTES[s->id][s->x0 + DECALAGE_CLE];
+}
+
+/**
+ * @brief Calcule la clé de l'occupation des lignes de 0 à n - 1 : le ou exclusif des clés de leurs
+ * cases occupées.
+ * @param modele représente le modèle du jeu.
+ * @param n représente le nombre de lignes.
+ * @return la clé des lignes.
+ */
+static uint64_t cleLignes(Modele *modele, int n) {
+  uint64_t cle = 0, ligne;
+  for (int y = 0; y < n; y++)
+    for (ligne = modele->lignes[y]; ligne; ligne &= ligne - 1)
+      cle ^= CLES_CASES[y][__builtin_ctzll(ligne)];
+  return cle;
+}
+
+/**
+ * @brief Recalcule les hauteurs et les trous des colonnes à partir de l'occupation des lignes en
+ * parcourant le terrain de haut en bas.
+ * @param modele représente le modèle du jeu. (Paramètre modifié)
+ */
+static void recalculeColonnes(Modele *modele) {
+  uint64_t vues = 0, sommets, trous;
+  memset(modele->hauteurs, 0, sizeof(modele->hauteurs));
+  memset(modele->trous, 0, sizeof(modele->trous));
+  modele->hauteurPile = modele->nbTrous = 0;
+  for (int y = 0; y < modele->nbLignes; y++) {
+    // Les cases occupées dans des colonnes encore vides sont des sommets
+    sommets = modele->lignes[y] & ~vues;
+    // Les cases libres dans des colonnes déjà vues sont des trous
+    trous = vues & ~modele->lignes[y];
+    if (sommets && !vues)
+      modele->hauteurPile = modele->nbLignes - y;
+    for (; sommets; sommets &= sommets - 1)
+      modele->hauteurs[__builtin_ctzll(sommets)] = modele->nbLignes - y;
+    modele->nbTrous += __builtin_popcountll(trous);
+    for (; trous; trous &= trous - 1)
+      modele->trous[__builtin_ctzll(trous)]++;
+    vues |= modele->lignes[y];
+  }
+}
+
+/**
+ * @brief Supprime des lignes en une seule passe en tassant les lignes restantes vers le bas, ajoute
+ * le score puis met à jour le délai et le coefficient d'ajout.
+ * @param modele représente le modèle du jeu. (Paramètre modifié)
+ * @param supprimees représente le masque des lignes à supprimer.
+ */
+static void supprimeLignes(Modele *modele, uint64_t supprimees) {
+  int i, j, bas;
+  uint32_t baisse;
+  if (supprimees) {
+    // On tasse de bas en haut les lignes restantes à partir de la plus basse ligne supprimée, en
+    // retirant leurs cases de l'empreinte avant et en les remettant après
+    j = bas = 63 - __builtin_clzll(supprimees);
+    modele->empreinte ^= cleLignes(modele, bas + 1);
+    for (i = j; i >= 0; i--) {
+      if ((supprimees >> i) & 1)
+        continue;
+      modele->lignes[j] = modele->lignes[i];
+      memcpy(modele->terrain + j * modele->nbColonnes, modele->terrain + i * modele->nbColonnes,
+             modele->nbColonnes);
+      j--;
+    }
+    // On met du noir sur les lignes libérées en haut
+    memset(modele->lignes, 0, (j + 1) * sizeof(uint64_t));
+    memset(modele->terrain, NOIR, (j + 1) * modele->nbColonnes);
+    modele->empreinte ^= cleLignes(modele, bas + 1);
+    // On ajoute le score
+    modele->score += __builtin_popcountll(supprimees) * modele->coef;
+    // On met à jour les colonnes
+    recalculeColonnes(modele);
+  }
+  // On met à jour le délai et le coefficient d'ajout. Plusieurs niveaux peuvent être passés d'un
+  // coup (4 lignes à un grand coefficient), le délai s'arrête alors à DELAI_MIN au lieu de passer
+  // sous zéro
+  if (modele->delai > DELAI_MIN) {
+    baisse = COEF_DELAI * ((modele->score / 10) + 1 - modele->coef);
+    modele->delai = modele->delai > baisse + DELAI_MIN ? modele->delai - baisse : DELAI_MIN;
+    modele->coef = (modele->score / 10) + 1;
+  }
+}
 
 /**
  * @brief Implémentation de la fonction initModele.
  */
-Modele *initModele(uint16_t nbLignes, uint16_t nbColonnes) {
-  // Création du modèle
-  Modele *modele = (Modele *)calloc(1, sizeof(Modele));
+Modele *initModele(uint16_t nbLignes, uint16_t nbColonnes, uint64_t graine) {
+  // Vérification du nombre de colonnes
+  if (nbColonnes < MIN_COLONNES || nbColonnes > MAX_COLONNES) {
+    fprintf(stderr, "Erreur à la création du modèle : Entre %d et %d colonnes\n", MIN_COLONNES,
+            MAX_COLONNES);
+    return NULL;
+  }
+  // Vérification du nombre de lignes
+  if (nbLignes < MIN_LIGNES || nbLignes + BASE > MAX_LIGNES) {
+    fprintf(stderr, "Erreur à la création du modèle : Entre %d et %d lignes\n", MIN_LIGNES,
+            MAX_LIGNES - BASE);
+    return NULL;
+  }
+  // Création du modèle et de son terrain en un seul bloc
+  Modele *modele = (Modele *)calloc(1, sizeof(Modele) + (nbLignes + BASE) * nbColonnes);
   if (!modele) {
     perror("Erreur à la création du modèle : Allocation mémoire échouée");
     return NULL;
@@ -30,33 +168,19 @@ Modele *initModele(uint16_t nbLignes, uint16_t nbColonnes) {
   modele->nbLignes = nbLignes + BASE;
   /// Initilisation du nombre de colonnes
   modele->nbColonnes = nbColonnes;
-  // Initialisation de la forme courante et gestion d'erreur
-  modele->forme = initForme(modele);
-  if (!modele->forme) {
-    free(modele);
-    return NULL;
-  }
-  // Initialisation de la forme suivante et gestion d'erreur
-  modele->suivante = initForme(modele);
-  if (!modele->suivante) {
-    detruitForme(modele->forme);
-    free(modele);
-    return NULL;
-  }
-  // Création du terrain et gestion d'erreur
-  modele->terrain = (Couleur *)malloc(modele->nbLignes * modele->nbColonnes * sizeof(Couleur));
-  if (!modele->terrain) {
-    perror("Erreur à la création du terrain : Allocation mémoire échouée");
-    detruitForme(modele->forme);
-    detruitForme(modele->suivante);
-    free(modele);
-    return NULL;
-  }
+  // Initialisation du générateur des formes
+  modele->graine = graine;
+  initAlea(&modele->alea, graine);
+  // Initialisation de la forme courante
+  initForme(modele, &modele->forme);
+  // Initialisation de la forme suivante
+  initForme(modele, &modele->suivante);
+  // Initialisation du masque d'une ligne pleine
+  modele->lignePleine = nbColonnes == MAX_COLONNES ? UINT64_MAX : (1ULL << nbColonnes) - 1;
   // Initialisation du terrain
-  int i, j;
-  for (i = 0; i < modele->nbLignes; i++)
-    for (j = 0; j < modele->nbColonnes; j++)
-      modele->terrain[i * modele->nbColonnes + j] = NOIR;
+  memset(modele->terrain, NOIR, modele->nbLignes * modele->nbColonnes);
+  // Initialisation de l'empreinte (le terrain est vide)
+  modele->empreinte = cleFormes(modele);
   return modele;
 }
 
@@ -64,26 +188,113 @@ Modele *initModele(uint16_t nbLignes, uint16_t nbColonnes) {
  * @brief Implémentation de la fonction detruitModele.
  */
 void detruitModele(Modele *modele) {
-  if (!modele)
-    return;
-  // Destruction du terrain
-  if (modele->terrain)
-    free(modele->terrain);
-  // Destruction de la forme courante
-  detruitForme(modele->forme);
-  // Destruction de la forme suivante
-  detruitForme(modele->suivante);
-  // Destruction du modèle
+  // Destruction du modèle (Les formes, les lignes et le terrain sont dans le modèle)
   free(modele);
 }
 
+/**
+ * @brief Implémentation de la fonction getTailleModele.
+ */
+size_t getTailleModele(Modele *modele) {
+  return sizeof(Modele) + modele->nbLignes * modele->nbColonnes;
+}
+
+/**
+ * @brief Implémentation de la fonction instantaneModele.
+ */
+Modele *instantaneModele(Modele *modele, Arene *arene) {
+  Modele *instantane = (Modele *)alloueArene(arene, getTailleModele(modele));
+  if (instantane)
+    memcpy(instantane, modele, getTailleModele(modele));
+  return instantane;
+}
+
+/**
+ * @brief Implémentation de la fonction restaureModele.
+ */
+int8_t restaureModele(Modele *modele, const Modele *instantane) {
+  // Vérification des dimensions
+  if (modele->nbLignes != instantane->nbLignes || modele->nbColonnes != instantane->nbColonnes) {
+    fprintf(stderr, "Erreur à la restauration du modèle : Dimensions différentes\n");
+    return -1;
+  }
+  memcpy(modele, instantane, getTailleModele(modele));
+  return 0;
+}
+
+/**
+ * @brief Vérifie que la boîte d'une forme est dans le terrain.
+ * @param modele représente le modèle du jeu.
+ * @param forme représente la forme à vérifier.
+ * @return 1 si la forme est valide et 0 si non.
+ */
+static uint8_t formeValide(Modele *modele, Forme *forme) {
+  const Rotation *r;
+  if (forme->id >= NB_FORMES || forme->rotation >= NB_ROTATIONS || forme->couleur < ROUGE ||
+      forme->couleur > BLANC)
+    return 0;
+  r = getRotation(forme->id, forme->rotation);
+  return 0 <= forme->x0 + r->xMin && forme->x0 + r->xMin + r->larg <= modele->nbColonnes &&
+         0 <= forme->y0 + r->yMin && forme->y0 + r->yMin + r->haut <= modele->nbLignes;
+}
+
+/**
+ * @brief Implémentation de la fonction reconstruitModele.
+ */
+int8_t reconstruitModele(Modele *modele) {
+  uint64_t occupees;
+  int x, y;
+  // Vérification des formes (elles servent d'indices dans les tables)
+  if (!formeValide(modele, &modele->forme) || !formeValide(modele, &modele->suivante))
+    return -1;
+  // Vérification des valeurs du jeu et du générateur (un état nul ne tire que des zéros)
+  if (modele->delai > DELAI_MAX || !modele->coef ||
+      !(modele->alea.s[0] | modele->alea.s[1] | modele->alea.s[2] | modele->alea.s[3]) ||
+      (modele->nbLignes < 64 && modele->lignesSupprimees >> modele->nbLignes))
+    return -1;
+  // Vérification du terrain : des couleurs connues, occupées là où l'occupation le dit
+  for (y = 0; y < modele->nbLignes; y++) {
+    if (modele->lignes[y] & ~modele->lignePleine)
+      return -1;
+    for (x = 0, occupees = 0; x < modele->nbColonnes; x++) {
+      uint8_t c = modele->terrain[y * modele->nbColonnes + x];
+      if (c < ROUGE || c > NOIR)
+        return -1;
+      occupees |= (uint64_t)(c != NOIR) << x;
+    }
+    if (occupees != modele->lignes[y])
+      return -1;
+  }
+  for (; y < MAX_LIGNES; y++)
+    if (modele->lignes[y])
+      return -1;
+  // Le reste se déduit du terrain et des formes
+  recalculeColonnes(modele);
+  modele->empreinte = cleLignes(modele, modele->nbLignes) ^ cleFormes(modele);
+  return 0;
+}
+
 /**
  * @brief Implémentation de la fonction getScore.
  */
-uint16_t getScore(Modele *modele) {
+uint32_t getScore(Modele *modele) {
   return modele->score;
 }
 
+/**
+ * @brief Implémentation de la fonction getGraine.
+ */
+uint64_t getGraine(Modele *modele) {
+  return modele->graine;
+}
+
+/**
+ * @brief Implémentation de la fonction getEmpreinte.
+ */
+uint64_t getEmpreinte(Modele *modele) {
+  return modele->empreinte;
+}
+
 /**
  * @brief Implémentation de la fonction getDelai.
  */
@@ -115,39 +326,99 @@ void getTerrain(Modele *modele, Couleur *terrain, uint16_t x, uint16_t y, uint16
       terrain[i * w + j] = modele->terrain[(i + y) * modele->nbColonnes + j + x];
 }
 
+/**
+ * @brief Implémentation de la fonction getImage.
+ */
+void getImage(Modele *modele, Image *image) {
+  getCoordFormeCourante(modele, image->forme);
+  getCoordFormeFantome(modele, image->fantome);
+  getCoordFormeSuivante(modele, image->suivante);
+  image->couleurForme = getCouleurFormeCourante(modele);
+  image->couleurSuivante = getCouleurFormeSuivante(modele);
+  image->score = modele->score;
+  // Le terrain est copié d'un bloc, sans la base
+  memcpy(image->terrain, modele->terrain + BASE * modele->nbColonnes,
+         (modele->nbLignes - BASE) * modele->nbColonnes);
+}
+
 /**
  * @brief Implémentation de la fonction getCoordFormeCourante.
  */
 void getCoordFormeCourante(Modele *modele, Couple *coords) {
-  getCoordoneesTerrain(modele->forme, coords);
+  getCoordoneesTerrain(&modele->forme, coords);
+}
+
+/**
+ * @brief Implémentation de la fonction getCoordFormeFantome.
+ */
+void getCoordFormeFantome(Modele *modele, Couple *coords) {
+  uint16_t dist = getDistanceChute(modele);
+  getCoordoneesTerrain(&modele->forme, coords);
+  for (int i = 0; i < NB_CASES_FORME; i++)
+    coords[i].y += dist;
+}
+
+/**
+ * @brief Implémentation de la fonction getDistanceChute.
+ */
+uint16_t getDistanceChute(Modele *modele) {
+  return distanceChute(modele, &modele->forme);
 }
 
 /**
  * @brief Implémentation de la fonction getCoordFormeSuivante.
  */
 void getCoordFormeSuivante(Modele *modele, Couple *coords) {
-  getCoordonees(modele->suivante, coords);
+  getCoordonees(&modele->suivante, coords);
 }
 
 /**
  * @brief Implémentation de la fonction getCouleurFormeCourante.
  */
 Couleur getCouleurFormeCourante(Modele *modele) {
-  return getCouleur(modele->forme);
+  return getCouleur(&modele->forme);
 }
 
 /**
  * @brief Implémentation de la fonction getCouleurFormeSuivante.
  */
 Couleur getCouleurFormeSuivante(Modele *modele) {
-  return getCouleur(modele->suivante);
+  return getCouleur(&modele->suivante);
+}
+
+/**
+ * @brief Implémentation de la fonction getHauteurColonne.
+ */
+uint16_t getHauteurColonne(Modele *modele, uint16_t x) {
+  return modele->hauteurs[x];
+}
+
+/**
+ * @brief Implémentation de la fonction getTrousColonne.
+ */
+uint16_t getTrousColonne(Modele *modele, uint16_t x) {
+  return modele->trous[x];
+}
+
+/**
+ * @brief Implémentation de la fonction getHauteurPile.
+ */
+uint16_t getHauteurPile(Modele *modele) {
+  return modele->hauteurPile;
+}
+
+/**
+ * @brief Implémentation de la fonction getNbTrous.
+ */
+uint16_t getNbTrous(Modele *modele) {
+  return modele->nbTrous;
 }
 
 /**
  * @brief Implémentation de la fonction estOccupee.
  */
 uint8_t estOccupee(Modele *modele, uint16_t x, uint16_t y) {
-  return modele->terrain[y * modele->nbColonnes + x] != NOIR;
+  return (modele->lignes[y] >> x) & 1;
 }
 
 /**
@@ -159,9 +430,120 @@ void deposeForme(Modele *modele) {
   getCoordFormeCourante(modele, coords);
   // Récupération de la couleur
   Couleur couleur = getCouleurFormeCourante(modele);
+  int16_t x, y, sommet;
   // Parcours et ajout
-  for (int i = 0; i < NB_CASES_FORME; i++)
-    modele->terrain[coords[i].y * modele->nbColonnes + coords[i].x] = couleur;
+  for (int i = 0; i < NB_CASES_FORME; i++) {
+    x = coords[i].x, y = coords[i].y;
+    modele->terrain[y * modele->nbColonnes + x] = couleur;
+    if (estOccupee(modele, x, y))
+      continue;
+    modele->lignes[y] |= 1ULL << x;
+    modele->empreinte ^= CLES_CASES[y][x];
+    // Si la case est au dessus du sommet, les cases libres entre les deux deviennent des trous
+    sommet = modele->nbLignes - modele->hauteurs[x];
+    if (y < sommet) {
+      modele->trous[x] += sommet - y - 1;
+      modele->nbTrous += sommet - y - 1;
+      modele->hauteurs[x] = modele->nbLignes - y;
+      if (modele->hauteurs[x] > modele->hauteurPile)
+        modele->hauteurPile = modele->hauteurs[x];
+    }
+    // Si non elle bouche un trou
+    else {
+      modele->trous[x]--;
+      modele->nbTrous--;
+    }
+  }
+}
+
+/**
+ * @brief Implémentation de la fonction joueDepot.
+ */
+void joueDepot(Modele *modele, uint8_t rotation, int16_t x0, int16_t y0, Depot *depot) {
+  const Rotation *r = getRotation(modele->forme.id, rotation);
+  int16_t x, y;
+  int i, k;
+  // On note l'état du modèle avant le dépôt
+  depot->forme = modele->forme, depot->suivante = modele->suivante;
+  depot->alea = modele->alea;
+  depot->empreinte = modele->empreinte, depot->lignesSupprimees = modele->lignesSupprimees;
+  depot->score = modele->score, depot->delai = modele->delai, depot->coef = modele->coef;
+  depot->hauteurPile = modele->hauteurPile, depot->nbTrous = modele->nbTrous;
+  // On place la forme et on note les cases et les colonnes qu'elle va écrire
+  formePlace(modele, rotation, x0, y0);
+  getCoordFormeCourante(modele, depot->cases);
+  depot->occupees = 0;
+  for (i = 0; i < NB_CASES_FORME; i++) {
+    x = depot->cases[i].x, y = depot->cases[i].y;
+    depot->couleurs[i] = modele->terrain[y * modele->nbColonnes + x];
+    depot->occupees |= estOccupee(modele, x, y) << i;
+  }
+  depot->xMin = x0 + r->xMin, depot->larg = r->larg;
+  memcpy(depot->hauteurs, modele->hauteurs + depot->xMin, depot->larg);
+  memcpy(depot->trous, modele->trous + depot->xMin, depot->larg);
+  // On dépose la forme
+  deposeForme(modele);
+  // Seules les lignes de la forme peuvent être devenues complètes, on note leurs couleurs de la
+  // plus basse à la plus haute avant de les supprimer
+  depot->supprimees = 0;
+  for (i = 0; i < NB_CASES_FORME; i++) {
+    y = depot->cases[i].y;
+    if (y >= BASE && estLigneComplete(modele, y))
+      depot->supprimees |= 1ULL << y;
+  }
+  for (y = modele->nbLignes - 1, k = 0; y >= BASE; y--)
+    if ((depot->supprimees >> y) & 1)
+      memcpy(depot->lignes[k++], modele->terrain + y * modele->nbColonnes, modele->nbColonnes);
+  supprimeLignes(modele, depot->supprimees);
+  modele->lignesSupprimees = depot->supprimees;
+  // On affecte la suivante à la courante et on en tire une nouvelle à la même place
+  modele->empreinte ^= cleFormes(modele);
+  modele->forme = modele->suivante;
+  initForme(modele, &modele->suivante);
+  modele->empreinte ^= cleFormes(modele);
+}
+
+/**
+ * @brief Implémentation de la fonction annuleDepot.
+ */
+void annuleDepot(Modele *modele, const Depot *depot) {
+  int i, j, k, x, y;
+  // On remet les lignes supprimées en détassant de haut en bas : la ligne i restante avait été
+  // descendue du nombre de lignes supprimées sous elle
+  if (depot->supprimees) {
+    j = k = __builtin_popcountll(depot->supprimees);
+    for (i = 0; i < j; i++) {
+      if ((depot->supprimees >> i) & 1) {
+        modele->lignes[i] = modele->lignePleine;
+        memcpy(modele->terrain + i * modele->nbColonnes, depot->lignes[--k], modele->nbColonnes);
+        continue;
+      }
+      modele->lignes[i] = modele->lignes[j];
+      memcpy(modele->terrain + i * modele->nbColonnes, modele->terrain + j * modele->nbColonnes,
+             modele->nbColonnes);
+      j++;
+    }
+  }
+  // On retire la forme en remettant les anciennes cases
+  for (i = NB_CASES_FORME - 1; i >= 0; i--) {
+    x = depot->cases[i].x, y = depot->cases[i].y;
+    modele->terrain[y * modele->nbColonnes + x] = depot->couleurs[i];
+    if (!((depot->occupees >> i) & 1))
+      modele->lignes[y] &= ~(1ULL << x);
+  }
+  // On remet les colonnes (toutes si des lignes ont été supprimées)
+  if (depot->supprimees)
+    recalculeColonnes(modele);
+  else {
+    memcpy(modele->hauteurs + depot->xMin, depot->hauteurs, depot->larg);
+    memcpy(modele->trous + depot->xMin, depot->trous, depot->larg);
+  }
+  // On remet l'état du modèle d'avant le dépôt
+  modele->forme = depot->forme, modele->suivante = depot->suivante;
+  modele->alea = depot->alea;
+  modele->empreinte = depot->empreinte, modele->lignesSupprimees = depot->lignesSupprimees;
+  modele->score = depot->score, modele->delai = depot->delai, modele->coef = depot->coef;
+  modele->hauteurPile = depot->hauteurPile, modele->nbTrous = depot->nbTrous;
 }
 
 /**
@@ -169,127 +551,137 @@ void deposeForme(Modele *modele) {
  */
 int8_t formeAvance(Modele *modele) {
   // Si il y'a collision
-  if (estEnCollision(modele->forme)) {
-    // On dépose la forme courante
-    deposeForme(modele);
-    // On détruit la forme courante
-    detruitForme(modele->forme);
-    // On supprime les lignes complètes
-    supprimeLignesCompletes(modele);
-    // On affecte la suivante à la courante
-    modele->forme = modele->suivante;
-    // On initialise une nouvelle à la suivante
-    modele->suivante = initForme(modele);
-    if (!modele->suivante)
-      return -1;
+  if (estEnCollision(modele, &modele->forme)) {
+    // On dépose la forme courante là où elle est (le dépôt n'a pas à être annulé)
+    Depot depot;
+    joueDepot(modele, modele->forme.rotation, modele->forme.x0, modele->forme.y0, &depot);
     return 1;
   }
   // Si non on fait avancer
-  avance(modele->forme);
+  modele->empreinte ^= cleFormes(modele);
+  avance(&modele->forme);
+  modele->empreinte ^= cleFormes(modele);
   return 0;
 }
 
+/**
+ * @brief Implémentation de la fonction formePlace.
+ */
+void formePlace(Modele *modele, uint8_t rotation, int16_t x0, int16_t y0) {
+  modele->empreinte ^= cleFormes(modele);
+  modele->forme.rotation = rotation;
+  modele->forme.x0 = x0;
+  modele->forme.y0 = y0;
+  modele->empreinte ^= cleFormes(modele);
+}
+
+/**
+ * @brief Implémentation de la fonction formeChute.
+ */
+int8_t formeChute(Modele *modele) {
+  // On fait tomber la forme puis on la dépose en la faisant avancer
+  modele->empreinte ^= cleFormes(modele);
+  chute(modele, &modele->forme);
+  modele->empreinte ^= cleFormes(modele);
+  return formeAvance(modele);
+}
+
 /**
  * @brief Implémentation de la fonction formeDecaleGauche.
  */
 void formeDecaleGauche(Modele *modele) {
-  decaleGauche(modele->forme);
+  modele->empreinte ^= cleFormes(modele);
+  decaleGauche(modele, &modele->forme);
+  modele->empreinte ^= cleFormes(modele);
 }
 
 /**
  * @brief Implémentation de la fonction formeDecaleDroite.
  */
 void formeDecaleDroite(Modele *modele) {
-  decaleDroite(modele->forme);
+  modele->empreinte ^= cleFormes(modele);
+  decaleDroite(modele, &modele->forme);
+  modele->empreinte ^= cleFormes(modele);
 }
 
 /**
  * @brief Implémentation de la fonction formeTourne.
  */
 void formeTourne(Modele *modele) {
-  tourne(modele->forme);
+  modele->empreinte ^= cleFormes(modele);
+  tourne(modele, &modele->forme);
+  modele->empreinte ^= cleFormes(modele);
 }
 
 /**
  * @brief Implémentation de la fonction estLigneComplete.
  */
 uint8_t estLigneComplete(Modele *modele, uint16_t y) {
-  // On parcours et on retourne 0 si une case n'est pas occupée
-  for (int i = 0; i < modele->nbColonnes; i++)
-    if (!estOccupee(modele, i, y))
-      return 0;
-  return 1;
+  // La ligne est complète si tous ses bits sont à 1
+  return modele->lignes[y] == modele->lignePleine;
 }
 
 /**
  * @brief Implémentation de la fonction supprimeLigne
  */
 void supprimeLigne(Modele *modele, uint16_t y) {
-  int i, j;
-  // On parcours les lignes à partir de la ligne y
-  for (i = y; i >= 0; i--)
-    for (j = 0; j < modele->nbColonnes; j++) {
-      // Si c'est la première ligne, on met du Noir
-      if (i == 0)
-        modele->terrain[j] = NOIR;
-      // Si non on met les couleurs du dessus
-      else
-        modele->terrain[i * modele->nbColonnes + j] =
-            modele->terrain[(i - 1) * modele->nbColonnes + j];
-    }
+  // On décale les lignes au dessus de y d'une ligne vers le bas en retirant leurs cases de
+  // l'empreinte avant et en les remettant après
+  modele->empreinte ^= cleLignes(modele, y + 1);
+  memmove(modele->lignes + 1, modele->lignes, y * sizeof(uint64_t));
+  memmove(modele->terrain + modele->nbColonnes, modele->terrain, y * modele->nbColonnes);
+  // On met du noir sur la première ligne
+  modele->lignes[0] = 0;
+  memset(modele->terrain, NOIR, modele->nbColonnes);
+  modele->empreinte ^= cleLignes(modele, y + 1);
+  // On met à jour les colonnes
+  recalculeColonnes(modele);
 }
 
 /**
  * @brief Implémentation de la fonction supprimeLignesCompletes.
  */
-void supprimeLignesCompletes(Modele *modele) {
-  // On parcours les lignes
+uint64_t supprimeLignesCompletes(Modele *modele) {
+  uint64_t supprimees = 0;
+  // On cherche toutes les lignes complètes
   for (int i = BASE; i < modele->nbLignes; i++)
-    // Si la ligne est complete, on la supprime et on ajoute le score
-    if (estLigneComplete(modele, i)) {
-      supprimeLigne(modele, i);
-      modele->score += modele->coef;
-    }
-  // On met à jour le délai et le coefficient d'ajout
-  if (modele->delai > DELAI_MIN) {
-    modele->delai -= COEF_DELAI * ((modele->score / 10) + 1 - modele->coef);
-    modele->coef = (modele->score / 10) + 1;
-  }
+    if (estLigneComplete(modele, i))
+      supprimees |= 1ULL << i;
+  supprimeLignes(modele, supprimees);
+  return supprimees;
+}
+
+/**
+ * @brief Implémentation de la fonction getLignesSupprimees.
+ */
+uint64_t getLignesSupprimees(Modele *modele) {
+  return modele->lignesSupprimees;
 }
 
 /**
  * @brief Implémentation de la fonction estTerminee.
  */
 uint8_t estTermine(Modele *modele) {
-  // On parcours la base
-  for (int i = 0; i < modele->nbColonnes; i++)
-    // Si il y'a une case occupée, c'est fini
-    if (estOccupee(modele, i, 0))
-      return 1;
-  return 0;
+  // Si la pile atteint la base, c'est fini
+  return modele->hauteurPile == modele->nbLignes;
 }
 
 /**
  * @brief Implémentation de la fonction recommenceModele.
  */
 int8_t recommenceModele(Modele *modele) {
-  int i, j;
-  // On parcours pour nettoyer le terrain
-  for (i = 0; i < modele->nbLignes; i++)
-    for (j = 0; j < modele->nbColonnes; j++)
-      modele->terrain[i * modele->nbColonnes + j] = NOIR;
-  // On detruit les anciennes formes
-  detruitForme(modele->forme);
-  detruitForme(modele->suivante);
-  // On choisit des nouvelles formes
-  modele->forme = initForme(modele);
-  if (!modele->forme)
-    return -1;
-  modele->suivante = initForme(modele);
-  if (!modele->suivante)
-    return -1;
-  // On reinitialise le delai et le score
+  // On nettoie le terrain
+  memset(modele->terrain, NOIR, modele->nbLignes * modele->nbColonnes);
+  memset(modele->lignes, 0, modele->nbLignes * sizeof(uint64_t));
+  recalculeColonnes(modele);
+  // On choisit des nouvelles formes à la place des anciennes
+  initForme(modele, &modele->forme);
+  initForme(modele, &modele->suivante);
+  modele->empreinte = cleFormes(modele);
+  // On reinitialise le delai, le coefficient, le score et les lignes supprimées au dernier tour
   modele->delai = DELAI_MAX;
+  modele->coef = 1;
   modele->score = 0;
+  modele->lignesSupprimees = 0;
   return 0;
 }
\ No newline at end of file
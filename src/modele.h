@@ -3,37 +3,109 @@
 
 #include <stdint.h>
 
+#include "alea.h"
+#include "arene.h"
+
 // Macro servant de marge dans le terrain du jeu
 #define BASE 1
 // Macro pour la taille d'une forme (Toutes les formes ont 4 cases)
 #define NB_CASES_FORME 4
+// Macro pour le nombre de formes différentes
+#define NB_FORMES 7
+// Macro pour le nombre d'états de rotation d'une forme
+#define NB_ROTATIONS 4
+// Macro pour le nombre maximum de colonnes (Une ligne du terrain tient dans un mot de 64 bits)
+#define MAX_COLONNES 64
+// Macro pour le nombre minimum de colonnes (Une forme apparaît entre la 2e et l'avant-dernière)
+#define MIN_COLONNES 3
+// Macro pour le nombre minimum de lignes sans compter la base (La forme I debout tient en hauteur)
+#define MIN_LIGNES 4
+// Macro pour le nombre maximum de lignes en comptant la base (Une ligne par bit d'un mot de 64 bits)
+#define MAX_LIGNES 64
 
 
 // dépendance entre la forme et le modèle
-typedef struct forme Forme;
+typedef struct modele Modele;
 
-// Enumération des couleurs dans le jeu
-typedef enum couleur { ROUGE = 1, VERT, JAUNE, BLEU, MAGENTA, CYAN, BLANC, NOIR } Couleur;
+// Enumération des couleurs dans le jeu (GRIS sert à afficher la forme fantôme)
+typedef enum couleur { ROUGE = 1, VERT, JAUNE, BLEU, MAGENTA, CYAN, BLANC, NOIR, GRIS } Couleur;
 
 // Structure d'un couple d'entier
 typedef struct couple {
   int16_t x, y;
 } Couple;
 
-// Structure du modèle du jeu Tetris
-typedef struct modele {
-  uint16_t nbLignes, nbColonnes, score, delai, coef;
-  Forme *forme, *suivante;
-  Couleur *terrain;
-} Modele;
+// Structure d'une forme du jeu Tetris (Ses cases sont dans la table des rotations)
+typedef struct forme {
+  uint8_t id, rotation;
+  int16_t x0, y0;
+  Couleur couleur;
+} Forme;
+
+// Structure du modèle du jeu Tetris. Le modèle est un seul bloc sans pointeur (les formes, les
+// lignes et le terrain sont dedans) : on peut le copier d'un seul memcpy de getTailleModele octets
+struct modele {
+  uint16_t nbLignes, nbColonnes, delai, coef;
+  // Score sur 32 bits : une IA peut jouer assez longtemps pour dépasser 16 bits
+  uint32_t score;
+  Forme forme, suivante;
+  // Graine et état du générateur qui choisit les formes (propres à chaque modèle)
+  uint64_t graine;
+  Alea alea;
+  // Occupation du terrain : un mot par ligne, le bit x est à 1 si la case (x, y) est occupée
+  uint64_t lignes[MAX_LIGNES], lignePleine;
+  // Masque des lignes supprimées lors du dernier dépôt d'une forme (le bit y pour la ligne y)
+  uint64_t lignesSupprimees;
+  // Hauteur et nombre de trous de chaque colonne (Un trou est une case libre sous le sommet)
+  uint8_t hauteurs[MAX_COLONNES], trous[MAX_COLONNES];
+  // Hauteur de la pile (la plus haute colonne) et nombre total de trous
+  uint16_t hauteurPile, nbTrous;
+  // Empreinte de Zobrist de l'occupation du terrain, de la forme courante et de la suivante
+  uint64_t empreinte;
+  // Couleur de chaque case du terrain, ligne par ligne (nbLignes * nbColonnes cases)
+  uint8_t terrain[];
+};
+
+// Structure d'une image du modèle : ce qu'il faut pour l'afficher, d'un seul bloc sans pointeur.
+// Les coordonnées des formes sont celles de getCoordFormeCourante, getCoordFormeFantome et
+// getCoordFormeSuivante, le terrain est celui de getTerrain sans la base
+typedef struct image {
+  Couple forme[NB_CASES_FORME], fantome[NB_CASES_FORME], suivante[NB_CASES_FORME];
+  Couleur couleurForme, couleurSuivante;
+  uint32_t score;
+  uint8_t terrain[MAX_LIGNES * MAX_COLONNES];
+} Image;
+
+// Structure d'un dépôt de forme : tout ce qu'il faut pour l'annuler
+typedef struct depot {
+  // Formes, générateur et valeurs du modèle avant le dépôt
+  Forme forme, suivante;
+  Alea alea;
+  uint64_t empreinte, lignesSupprimees;
+  uint32_t score;
+  uint16_t delai, coef, hauteurPile, nbTrous;
+  // Cases écrites par la forme avec leur ancienne couleur et leur ancienne occupation
+  Couple cases[NB_CASES_FORME];
+  uint8_t couleurs[NB_CASES_FORME];
+  uint8_t occupees;
+  // Hauteurs et trous des colonnes de la forme avant le dépôt
+  uint8_t xMin, larg, hauteurs[NB_CASES_FORME], trous[NB_CASES_FORME];
+  // Lignes supprimées par le dépôt et leurs couleurs (de la plus basse à la plus haute)
+  uint64_t supprimees;
+  uint8_t lignes[NB_CASES_FORME][MAX_COLONNES];
+} Depot;
 
 /**
  * @brief Crée et initialise le modèle du jeu tetris.
- * @param nbLignes représente le nombre de ligne du terrain du jeu.
- * @param nbColonnes représente le nombre de colonnes du terrain du jeu.
+ * @param nbLignes représente le nombre de ligne du terrain du jeu (entre MIN_LIGNES et
+ * MAX_LIGNES - BASE).
+ * @param nbColonnes représente le nombre de colonnes du terrain du jeu (entre MIN_COLONNES et
+ * MAX_COLONNES).
+ * @param graine représente la graine du générateur des formes. Une même graine et les mêmes
+ * actions donnent la même partie.
  * @return le modèle crée (que l'on doit liberer) ou NULL si il y'a erreur.
  */
-Modele *initModele(uint16_t nbLignes, uint16_t nbColonnes);
+Modele *initModele(uint16_t nbLignes, uint16_t nbColonnes, uint64_t graine);
 
 /**
  * @brief Détruit et libère l'espace occupée par le modèle du jeu.
@@ -41,12 +113,63 @@ Modele *initModele(uint16_t nbLignes, uint16_t nbColonnes);
  */
 void detruitModele(Modele *modele);
 
+/**
+ * @brief Permet d'avoir la taille en octets du bloc du modèle (terrain compris).
+ * @param modele représente le modèle du jeu.
+ * @return la taille du modèle.
+ */
+size_t getTailleModele(Modele *modele);
+
+/**
+ * @brief Prend un instantané du modèle dans une arène : une copie d'un seul bloc (terrain, formes,
+ * score, délai et générateur) qui est elle même un modèle utilisable, par exemple pour essayer une
+ * suite de coups sans toucher à la partie. Il n'y a rien à libérer en dehors de l'arène.
+ * @param modele représente le modèle du jeu.
+ * @param arene représente l'arène où copier le modèle. (Paramètre modifié)
+ * @return l'instantané ou NULL si l'arène est pleine.
+ */
+Modele *instantaneModele(Modele *modele, Arene *arene);
+
+/**
+ * @brief Remet un modèle dans l'état d'un instantané (ou d'un autre modèle) de mêmes dimensions
+ * d'un seul memcpy.
+ * @param modele représente le modèle à remettre. (Paramètre modifié)
+ * @param instantane représente l'instantané à recopier.
+ * @return 0 si tous s'est bien passée et -1 si non.
+ */
+int8_t restaureModele(Modele *modele, const Modele *instantane);
+
+/**
+ * @brief Vérifie un modèle dont seuls le terrain, l'occupation des lignes, les formes, le score,
+ * le délai, le coefficient, le générateur et les lignes supprimées ont été remplis (par exemple
+ * depuis un fichier) puis recalcule le reste (colonnes, trous et empreinte).
+ * @param modele représente le modèle à vérifier, avec ses dimensions. (Paramètre modifié)
+ * @return 0 si le modèle est valide et -1 si non.
+ */
+int8_t reconstruitModele(Modele *modele);
+
 /**
  * @brief Permet d'avoir le score du jeu.
  * @param modele représente le modèle du jeu.
  * @return le score du joueur dans la partie.
  */
-uint16_t getScore(Modele *modele);
+uint32_t getScore(Modele *modele);
+
+/**
+ * @brief Permet d'avoir la graine avec laquelle le modèle a été créé.
+ * @param modele représente le modèle du jeu.
+ * @return la graine du générateur des formes.
+ */
+uint64_t getGraine(Modele *modele);
+
+/**
+ * @brief Permet d'avoir l'empreinte de l'état du jeu : l'occupation du terrain, la forme courante
+ * (forme, rotation et position) et la suivante. Elle est tenue à jour à chaque changement, deux
+ * états égaux ont donc la même empreinte sans avoir à comparer leurs terrains.
+ * @param modele représente le modèle du jeu.
+ * @return l'empreinte sur 64 bits.
+ */
+uint64_t getEmpreinte(Modele *modele);
 
 /**
  * @brief Permet d'avoir le délai d'attente avant chaque itération. Cela nous permet de controler la
@@ -81,6 +204,14 @@ uint16_t getNbColonnes(Modele *modele);
  */
 void getTerrain(Modele *modele, Couleur *terrain, uint16_t x, uint16_t y, uint16_t w, uint16_t h);
 
+/**
+ * @brief Copie dans une image tout ce qu'il faut pour afficher le modèle. L'image ne dépend plus
+ * du modèle ensuite, on peut donc la dessiner pendant que le jeu continue.
+ * @param modele représente le modèle du jeu.
+ * @param image représente l'image à remplir. (Paramètre modifié)
+ */
+void getImage(Modele *modele, Image *image);
+
 /**
  * @brief Permet d'avoir les coordonnées de la forme courante dans le terrain.
  * @param modele représente le modèle du jeu contenant la forme.
@@ -88,6 +219,21 @@ void getTerrain(Modele *modele, Couleur *terrain, uint16_t x, uint16_t y, uint16
  */
 void getCoordFormeCourante(Modele *modele, Couple *coords);
 
+/**
+ * @brief Permet d'avoir les coordonnées de la forme fantôme c'est à dire de la forme courante à
+ * l'endroit où elle tomberait.
+ * @param modele représente le modèle du jeu contenant la forme.
+ * @param coords représente un pointeur vers un espace où stocker les coordonnées.
+ */
+void getCoordFormeFantome(Modele *modele, Couple *coords);
+
+/**
+ * @brief Permet d'avoir le nombre de cases dont la forme courante peut descendre.
+ * @param modele représente le modèle du jeu contenant la forme.
+ * @return la distance de chute de la forme courante.
+ */
+uint16_t getDistanceChute(Modele *modele);
+
 /**
  * @brief Permet d'avoir les coordonnées relatives de la forme suivante.
  * @param modele représente le modèle du jeu contenant la forme.
@@ -109,6 +255,38 @@ Couleur getCouleurFormeCourante(Modele *modele);
  */
 Couleur getCouleurFormeSuivante(Modele *modele);
 
+/**
+ * @brief Permet d'avoir la hauteur d'une colonne c'est à dire le nombre de lignes entre son sommet
+ * et le bas du terrain (base comprise).
+ * @param modele représente le modèle du jeu.
+ * @param x représente le numéro de la colonne.
+ * @return la hauteur de la colonne ou 0 si elle est vide.
+ */
+uint16_t getHauteurColonne(Modele *modele, uint16_t x);
+
+/**
+ * @brief Permet d'avoir le nombre de trous d'une colonne c'est à dire de cases libres sous son
+ * sommet.
+ * @param modele représente le modèle du jeu.
+ * @param x représente le numéro de la colonne.
+ * @return le nombre de trous de la colonne.
+ */
+uint16_t getTrousColonne(Modele *modele, uint16_t x);
+
+/**
+ * @brief Permet d'avoir la hauteur de la pile c'est à dire la hauteur de la plus haute colonne.
+ * @param modele représente le modèle du jeu.
+ * @return la hauteur de la pile.
+ */
+uint16_t getHauteurPile(Modele *modele);
+
+/**
+ * @brief Permet d'avoir le nombre total de trous du terrain.
+ * @param modele représente le modèle du jeu.
+ * @return le nombre de trous de toutes les colonnes.
+ */
+uint16_t getNbTrous(Modele *modele);
+
 /**
  * @brief Vérifie si la case de coordonnées (x, y) est occupée ou c'est à dire si sa couleur est
  * différente de NOIR.
@@ -121,18 +299,56 @@ uint8_t estOccupee(Modele *modele, uint16_t x, uint16_t y);
 
 /**
  * @brief Enregistre la forme sur le terrain en recopiant sa couleur sur ses coordonnées
- * dans le terain.
+ * dans le terain et met à jour les hauteurs et les trous des colonnes.
  * @param modele représente le modèle du jeu contenant la forme. (Paramètre modifié)
  */
 void deposeForme(Modele *modele);
 
+/**
+ * @brief Place directement la forme courante dans un état de rotation et à une origine données sans
+ * vérifier que la position est valide.
+ * @param modele représente le modèle du jeu contenant la forme. (Paramètre modifié)
+ * @param rotation représente l'état de rotation de la forme.
+ * @param x0 représente l'abscisse de l'origine de la forme.
+ * @param y0 représente l'ordonnée de l'origine de la forme.
+ */
+void formePlace(Modele *modele, uint8_t rotation, int16_t x0, int16_t y0);
+
+/**
+ * @brief Dépose la forme courante dans un état de rotation et à une origine données, supprime les
+ * lignes complètes puis fait apparaître la forme suivante, en notant dans le dépôt de quoi annuler
+ * le tout. C'est ainsi que toutes les formes sont déposées.
+ * @param modele représente le modèle du jeu contenant la forme. (Paramètre modifié)
+ * @param rotation représente l'état de rotation de la forme.
+ * @param x0 représente l'abscisse de l'origine de la forme.
+ * @param y0 représente l'ordonnée de l'origine de la forme.
+ * @param depot représente l'espace où noter le dépôt. (Paramètre modifié)
+ */
+void joueDepot(Modele *modele, uint8_t rotation, int16_t x0, int16_t y0, Depot *depot);
+
+/**
+ * @brief Annule un dépôt : le modèle revient exactement à son état d'avant (terrain, colonnes,
+ * score, délai, formes, générateur et empreinte). Les dépôts doivent être annulés du dernier au
+ * premier.
+ * @param modele représente le modèle du jeu. (Paramètre modifié)
+ * @param depot représente le dernier dépôt joué sur le modèle.
+ */
+void annuleDepot(Modele *modele, const Depot *depot);
+
 /**
  * @brief Déplace la forme courante d'une case vers le bas dans le terrain du jeu.
  * @param modele représente le modèle du jeu contenant la forme à avancer. (Paramètre modifié)
- * @return 1 si il y'a eu collision, 0 si non et -1 si il y'a eu erreur en créant la forme suivante
+ * @return 1 si il y'a eu collision et 0 si non.
  */
 int8_t formeAvance(Modele *modele);
 
+/**
+ * @brief Fait tomber la forme courante d'un coup puis la dépose sur le terrain du jeu.
+ * @param modele représente le modèle du jeu contenant la forme à faire tomber. (Paramètre modifié)
+ * @return 1 car la forme est toujours en collision après sa chute.
+ */
+int8_t formeChute(Modele *modele);
+
 /**
  * @brief Décale la forme courante d'une case vers la gauche dans le terrain du jeu.
  * @param modele représente le modèle du jeu contenant la forme à décaler. (Paramètre modifié)
@@ -170,10 +386,19 @@ uint8_t estLigneComplete(Modele *modele, uint16_t y);
 void supprimeLigne(Modele *modele, uint16_t y);
 
 /**
- * @brief Parcours le terrain du jeu et supprime toutes les lignes complètes.
+ * @brief Parcours le terrain du jeu et supprime toutes les lignes complètes en une seule passe
+ * en tassant les lignes restantes vers le bas.
  * @param modele représente le modèle du jeu. (Paramètre modifié)
+ * @return le masque des lignes supprimées (le bit y est à 1 si la ligne y a été supprimée).
+ */
+uint64_t supprimeLignesCompletes(Modele *modele);
+
+/**
+ * @brief Permet d'avoir les lignes supprimées lors du dernier dépôt d'une forme.
+ * @param modele représente le modèle du jeu.
+ * @return le masque des lignes supprimées (le bit y est à 1 si la ligne y a été supprimée).
  */
-void supprimeLignesCompletes(Modele *modele);
+uint64_t getLignesSupprimees(Modele *modele);
 
 /**
  * @brief Vérifie si le jeu est terminé c'est à dire si il y'a une forme qui deborde du terrain.
@@ -183,7 +408,8 @@ void supprimeLignesCompletes(Modele *modele);
 uint8_t estTermine(Modele *modele);
 
 /**
- * @brief Recommence le jeu en nettoyant le terrain du jeu.
+ * @brief Recommence le jeu en nettoyant le terrain du jeu. Le générateur des formes n'est pas
+ * réinitialisé, la nouvelle partie continue donc sa suite.
  * @param modele représente le modèle du jeu.
  * @return 0 si tous s'est bien passée et -1 si non.
  */
@@ -0,0 +1,136 @@
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "ordonnanceur.h"
+
+// Structure de la file de tâches d'un ouvrier : les indices de debut à fin - 1
+typedef struct {
+  pthread_mutex_t verrou;
+  uint32_t debut, fin;
+} File;
+
+// Structure partagée par tous les ouvriers
+typedef struct {
+  File *files;
+  uint16_t nbOuvriers;
+  Tache tache;
+  void *arg;
+} Ordonnanceur;
+
+// Structure des paramètres d'un thread ouvrier
+typedef struct {
+  Ordonnanceur *ord;
+  uint16_t numero;
+} Ouvrier;
+
+/**
+ * @brief Retire la première tâche de la file d'un ouvrier.
+ * @param file représente la file de l'ouvrier. (Paramètre modifié)
+ * @param indice représente un pointeur où stocker l'indice de la tâche.
+ * @return 1 si une tâche a été retirée et 0 si la file est vide.
+ */
+static uint8_t retireTache(File *file, uint32_t *indice) {
+  uint8_t ok = 0;
+  pthread_mutex_lock(&file->verrou);
+  if (file->debut < file->fin)
+    *indice = file->debut++, ok = 1;
+  pthread_mutex_unlock(&file->verrou);
+  return ok;
+}
+
+/**
+ * @brief Vole la moitié (arrondie au dessus) des tâches d'une autre file et les met dans la file
+ * de l'ouvrier.
+ * @param file représente la file de l'ouvrier voleur (vide). (Paramètre modifié)
+ * @param victime représente la file volée. (Paramètre modifié)
+ * @return 1 si des tâches ont été volées et 0 si la victime n'en avait pas.
+ */
+static uint8_t voleTaches(File *file, File *victime) {
+  uint32_t debut = 0, fin = 0;
+  pthread_mutex_lock(&victime->verrou);
+  if (victime->debut < victime->fin) {
+    fin = victime->fin;
+    debut = victime->fin -= (victime->fin - victime->debut + 1) / 2;
+  }
+  pthread_mutex_unlock(&victime->verrou);
+  if (debut == fin)
+    return 0;
+  pthread_mutex_lock(&file->verrou);
+  file->debut = debut, file->fin = fin;
+  pthread_mutex_unlock(&file->verrou);
+  return 1;
+}
+
+/**
+ * @brief Boucle d'un ouvrier : exécute ses tâches puis vole celles des autres jusqu'à ce qu'il
+ * n'y en ait plus nulle part.
+ * @param p représente les paramètres de l'ouvrier.
+ * @return NULL.
+ */
+static void *travaille(void *p) {
+  Ouvrier *ouvrier = (Ouvrier *)p;
+  Ordonnanceur *ord = ouvrier->ord;
+  File *file = &ord->files[ouvrier->numero];
+  uint32_t indice;
+  uint16_t i;
+  for (;;) {
+    while (retireTache(file, &indice))
+      ord->tache(indice, ouvrier->numero, ord->arg);
+    // On cherche une victime en partant de l'ouvrier suivant
+    for (i = 1; i < ord->nbOuvriers; i++)
+      if (voleTaches(file, &ord->files[(ouvrier->numero + i) % ord->nbOuvriers]))
+        break;
+    // Les tâches ne créent pas d'autres tâches : si toutes les files sont vides, c'est fini
+    if (i >= ord->nbOuvriers)
+      return NULL;
+  }
+}
+
+/**
+ * @brief Implémentation de la fonction executeEnParallele.
+ */
+int8_t executeEnParallele(uint32_t nbTaches, uint16_t nbOuvriers, Tache tache, void *arg) {
+  Ordonnanceur ord = {NULL, nbOuvriers ? nbOuvriers : getNbCoeurs(), tache, arg};
+  uint16_t i, lances;
+  // Création des files et des ouvriers
+  ord.files = (File *)malloc(ord.nbOuvriers * sizeof(File));
+  Ouvrier *ouvriers = (Ouvrier *)malloc(ord.nbOuvriers * sizeof(Ouvrier));
+  pthread_t *threads = (pthread_t *)malloc(ord.nbOuvriers * sizeof(pthread_t));
+  if (!ord.files || !ouvriers || !threads) {
+    perror("Erreur à la création de l'ordonnanceur : Allocation mémoire échouée");
+    free(ord.files), free(ouvriers), free(threads);
+    return -1;
+  }
+  // Répartition égale des tâches entre les ouvriers
+  for (i = 0; i < ord.nbOuvriers; i++) {
+    pthread_mutex_init(&ord.files[i].verrou, NULL);
+    ord.files[i].debut = (uint64_t)nbTaches * i / ord.nbOuvriers;
+    ord.files[i].fin = (uint64_t)nbTaches * (i + 1) / ord.nbOuvriers;
+    ouvriers[i] = (Ouvrier){&ord, i};
+  }
+  // Lancement des threads (le premier ouvrier est le thread appelant)
+  for (lances = 1; lances < ord.nbOuvriers; lances++)
+    if (pthread_create(&threads[lances], NULL, travaille, &ouvriers[lances])) {
+      fprintf(stderr, "Attention : %u threads ouvriers sur %u ont pu être créés\n", lances,
+              ord.nbOuvriers);
+      break;
+    }
+  // Les tâches des ouvriers non lancés sont volées par les autres, elles sont toutes exécutées
+  travaille(&ouvriers[0]);
+  for (i = 1; i < lances; i++)
+    pthread_join(threads[i], NULL);
+  for (i = 0; i < ord.nbOuvriers; i++)
+    pthread_mutex_destroy(&ord.files[i].verrou);
+  free(ord.files), free(ouvriers), free(threads);
+  return 0;
+}
+
+/**
+ * @brief Implémentation de la fonction getNbCoeurs.
+ */
+uint16_t getNbCoeurs(void) {
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  return n > 0 ? n : 1;
+}
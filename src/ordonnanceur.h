@@ -0,0 +1,32 @@
+#ifndef ORDONNANCEUR_H
+#define ORDONNANCEUR_H
+
+#include <stdint.h>
+
+// Macro pour le nombre maximum de threads qu'on peut demander à l'ordonnanceur
+#define MAX_OUVRIERS 256
+
+// Type d'une tâche : elle reçoit son indice, le numéro de l'ouvrier qui l'exécute et un argument
+typedef void (*Tache)(uint32_t indice, uint16_t ouvrier, void *arg);
+
+/**
+ * @brief Exécute les tâches d'indices 0 à nbTaches - 1 sur plusieurs threads avec vol de travail.
+ * Chaque ouvrier commence avec une part égale des tâches et, quand il n'en a plus, vole la moitié
+ * des tâches restantes d'un autre ouvrier. Les tâches longues et courtes s'équilibrent ainsi.
+ * @param nbTaches représente le nombre de tâches à exécuter.
+ * Si un thread ne peut pas être créé, ses tâches sont volées par les ouvriers lancés : toutes les
+ * tâches sont exécutées quand même.
+ * @param nbOuvriers représente le nombre de threads (0 pour un par coeur, au plus MAX_OUVRIERS).
+ * @param tache représente la fonction à exécuter pour chaque indice.
+ * @param arg représente l'argument passé à chaque tâche.
+ * @return 0 si toutes les tâches ont été exécutées et -1 si aucune ne l'a été (allocation échouée).
+ */
+int8_t executeEnParallele(uint32_t nbTaches, uint16_t nbOuvriers, Tache tache, void *arg);
+
+/**
+ * @brief Permet d'avoir le nombre de coeurs disponibles.
+ * @return le nombre de coeurs (au moins 1).
+ */
+uint16_t getNbCoeurs(void);
+
+#endif
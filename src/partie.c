@@ -0,0 +1,173 @@
+#include <stdlib.h>
+
+#include "partie.h"
+#include "tour.h"
+
+// Macro pour la taille du chemin de la forme courante vers le placement choisi par l'IA
+#define MAX_MOUVEMENTS 256
+
+/**
+ * @brief Implémentation de la fonction initPartie.
+ */
+int8_t initPartie(Partie *partie, uint16_t nbLignes, uint16_t nbColonnes, uint64_t graine,
+                  uint8_t avecIA) {
+  // Initialisation du modèle du jeu
+  partie->modele = initModele(nbLignes, nbColonnes, graine);
+  if (!partie->modele)
+    return -1;
+  // Initialisation de l'IA si elle doit jouer
+  partie->ia = NULL;
+  if (avecIA && !(partie->ia = initIA(LARGEUR_FAISCEAU))) {
+    detruitModele(partie->modele);
+    return -1;
+  }
+  // Initialisation du reste des variables
+  partie->delai = getDelai(partie->modele);
+  partie->estEnPause = 1;
+  partie->nbAppel = partie->estTermine = partie->aCible = partie->aAfficher = 0;
+  partie->errEtCollEvts = 0;
+  partie->tour = 0;
+  return 0;
+}
+
+/**
+ * @brief Implémentation de la fonction detruitPartie.
+ */
+void detruitPartie(Partie *partie) {
+  detruitIA(partie->ia);
+  detruitModele(partie->modele);
+}
+
+/**
+ * @brief Implémentation de la fonction recommencePartie.
+ */
+int8_t recommencePartie(Partie *partie) {
+  int err;
+  err = recommenceModele(partie->modele);
+  partie->estEnPause = 0;
+  partie->aCible = 0;
+  return err;
+}
+
+/**
+ * @brief Fait jouer l'IA : elle choisit un placement pour chaque nouvelle forme puis fait un
+ * mouvement vers ce placement à chaque appel, avec les mêmes fonctions que le joueur.
+ * @param partie représente la partie.
+ * @return 1 si la forme est tombée et 0 si non.
+ */
+static int8_t joueIA(Partie *partie) {
+  Mouvement mouvements[MAX_MOUVEMENTS];
+  int16_t nb, i;
+  // On choisit le placement de la nouvelle forme
+  if (!partie->aCible) {
+    if (choisitPlacementIA(partie->ia, partie->modele, &partie->cible))
+      return 0;
+    partie->aCible = 1;
+  }
+  // On cherche le chemin depuis la position actuelle (la forme a pu descendre entre temps)
+  nb = cheminPlacement(partie->modele, &partie->cible, mouvements, MAX_MOUVEMENTS);
+  if (nb < 0) {
+    // Le placement n'est plus atteignable, on en choisira un autre au prochain appel
+    partie->aCible = 0;
+    return 0;
+  }
+  // Si il ne reste qu'à descendre, on fait tomber la forme
+  for (i = 0; i < nb && mouvements[i] == DESCEND; i++)
+    ;
+  if (i == nb)
+    return formeChute(partie->modele);
+  // Si non on fait le premier mouvement
+  return joueMouvement(partie->modele, mouvements[0]);
+}
+
+/**
+ * @brief Implémentation de la fonction actionPartie.
+ */
+int8_t actionPartie(Partie *partie, Evenement evt) {
+  if (partie->estEnPause || partie->estTermine) {
+    switch (evt) {
+      case ENTREE :
+        partie->estEnPause = 0;
+        return 0;
+      case TOUCHE_R :
+        return recommencePartie(partie);
+      default :
+        return 0;
+    }
+  }
+  switch (evt) {
+    case FHAUT :
+      if (partie->delai + INC_DELAI <= getDelai(partie->modele))
+        partie->delai += INC_DELAI;
+      return 0;
+    case FBAS :
+      if (partie->delai - INC_DELAI >= 0)
+        partie->delai -= INC_DELAI;
+      return 0;
+    case FGAUCHE :
+      formeDecaleGauche(partie->modele);
+      return 0;
+    case FDROITE :
+      formeDecaleDroite(partie->modele);
+      return 0;
+    case ESPACE :
+      formeTourne(partie->modele);
+      return 0;
+    case TOUCHE_C :
+      return formeChute(partie->modele);
+    case ENTREE :
+      partie->estEnPause = 1;
+      return 0;
+    default :
+      return 0;
+  }
+}
+
+/**
+ * @brief Implémentation de la fonction joueEvenements.
+ */
+int8_t joueEvenements(Partie *partie, const Evenement *evts, uint16_t nbEvts) {
+  int8_t ret;
+  // Une forme tombée n'arrête pas les évènements d'après (ils vont à la suivante)
+  for (uint16_t i = 0; i < nbEvts && partie->errEtCollEvts != -1; i++)
+    if ((ret = actionPartie(partie, evts[i])))
+      partie->errEtCollEvts = ret;
+  return partie->errEtCollEvts;
+}
+
+/**
+ * @brief Implémentation de la fonction joueTour.
+ */
+int8_t joueTour(Partie *partie, const Evenement *evts, uint16_t nbEvts) {
+  int8_t errEtColl;
+
+  // On traite les évènements
+  errEtColl = joueEvenements(partie, evts, nbEvts);
+  partie->errEtCollEvts = 0;
+  // L'IA joue si elle est là et que le jeu continue
+  if (partie->ia && !errEtColl && !partie->estEnPause && !partie->estTermine)
+    errEtColl = joueIA(partie);
+
+  partie->estTermine = estTermine(partie->modele);
+  // Si la forme est tombée, on reinitialise le delai et on met à jour la vue tout de suite
+  if (errEtColl == 1) {
+    partie->delai = getDelai(partie->modele);
+    partie->nbAppel = MAX_APPEL;
+    partie->aCible = 0;
+  }
+  // Si le jeu n'est pas terminée ou en pause et que on a joué MAX_APPEL tours
+  else if (!partie->estTermine && !partie->estEnPause && partie->nbAppel >= MAX_APPEL) {
+    // On fait avancer la forme
+    errEtColl = formeAvance(partie->modele);
+    // On reinitialise le delai si il y'a eu collision
+    if (errEtColl == 1)
+      partie->delai = getDelai(partie->modele), partie->aCible = 0;
+  }
+
+  // La vue est à mettre à jour tous les MAX_APPEL tours
+  partie->aAfficher = partie->nbAppel >= MAX_APPEL;
+  if (partie->aAfficher)
+    partie->nbAppel = 0;
+  partie->nbAppel++, partie->tour++;
+  return errEtColl;
+}
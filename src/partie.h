@@ -0,0 +1,80 @@
+#ifndef PARTIE_H
+#define PARTIE_H
+
+#include "evenement.h"
+#include "ia.h"
+#include "modele.h"
+
+// Structure d'une partie : le modèle et l'état du jeu autour (pause, fin, délai, IA) sans
+// affichage. Elle avance d'un tour à chaque évènement, une même graine et les mêmes évènements
+// aux mêmes tours donnent donc la même partie.
+typedef struct partie {
+  uint16_t nbAppel, delai, estEnPause, estTermine;
+  // Numéro du tour en cours et 1 si la vue doit être mise à jour après ce tour
+  uint32_t tour;
+  uint8_t aAfficher;
+  // Résultat des évènements déjà joués pendant le tour en cours (1 si une forme est tombée)
+  int8_t errEtCollEvts;
+  Modele *modele;
+  // IA qui joue à la place du joueur (NULL si c'est le joueur) et placement qu'elle a choisi
+  IA *ia;
+  Placement cible;
+  uint8_t aCible;
+} Partie;
+
+/**
+ * @brief Initialise une partie en pause avec un nouveau modèle.
+ * @param partie représente la partie à initialiser. (Paramètre modifié)
+ * @param nbLignes représente le nombre de lignes du terrain du jeu.
+ * @param nbColonnes représente le nombre de colonnes du terrain du jeu.
+ * @param graine représente la graine du générateur des formes.
+ * @param avecIA vaut 1 si c'est l'IA qui joue et 0 si c'est le joueur.
+ * @return 0 si tous s'est bien passée et -1 si non.
+ */
+int8_t initPartie(Partie *partie, uint16_t nbLignes, uint16_t nbColonnes, uint64_t graine,
+                  uint8_t avecIA);
+
+/**
+ * @brief Détruit le modèle et l'IA de la partie.
+ * @param partie représente la partie à détruire.
+ */
+void detruitPartie(Partie *partie);
+
+/**
+ * @brief Permet de recommencer la partie.
+ * @param partie représente la partie. (Paramètre modifié)
+ * @return 0 si tous s'est bien passée et -1 si non.
+ */
+int8_t recommencePartie(Partie *partie);
+
+/**
+ * @brief Fait l'action correspondant à l'évènement en paramètre.
+ * @param partie représente la partie. (Paramètre modifié)
+ * @param evt représente l'évènement dont on va faire l'action.
+ * @return 1 si la forme est tombée, 0 si tous s'est bien passée et -1 si non.
+ */
+int8_t actionPartie(Partie *partie, Evenement evt);
+
+/**
+ * @brief Fait les actions des évènements dans l'ordre sans finir le tour en cours. Les jouer avant
+ * le tour revient à les donner à joueTour, le joueur les voit donc sans attendre le tour.
+ * @param partie représente la partie. (Paramètre modifié)
+ * @param evts représente les évènements.
+ * @param nbEvts représente le nombre d'évènements.
+ * @return 1 si une forme est tombée pendant le tour, 0 si tous s'est bien passée et -1 si non.
+ */
+int8_t joueEvenements(Partie *partie, const Evenement *evts, uint16_t nbEvts);
+
+/**
+ * @brief Joue un tour de la partie : fait les actions de tous les évènements du tour dans l'ordre
+ * (après ceux déjà joués par joueEvenements), fait jouer l'IA si elle est là puis fait avancer la
+ * forme tous les MAX_APPEL tours (tour.h). Le tour ne dépend que de l'état de la partie et des évènements,
+ * pas du temps écoulé.
+ * @param partie représente la partie. (Paramètre modifié)
+ * @param evts représente les évènements du tour.
+ * @param nbEvts représente le nombre d'évènements (0 si il n'y en a pas).
+ * @return 1 si une forme est tombée, 0 si tous s'est bien passée et -1 si non.
+ */
+int8_t joueTour(Partie *partie, const Evenement *evts, uint16_t nbEvts);
+
+#endif
@@ -0,0 +1,238 @@
+#include <string.h>
+
+#include "forme.h"
+#include "placement.h"
+
+/**
+ * @brief Calcule les positions libres d'un état de rotation sur toutes les lignes : le bit x de la
+ * ligne y est à 1 si la boîte de la forme peut avoir son bord gauche en x et son haut en y. Les
+ * lignes au-dessus de la pile sont libres partout sans avoir à regarder les cases de la forme.
+ * @param modele représente le modèle du jeu.
+ * @param r représente l'état de rotation.
+ * @param libres représente l'espace où stocker le masque de chaque ligne. (Paramètre modifié)
+ * @param haut représente le nombre de lignes où la boîte tient.
+ * @param vides représente le nombre de lignes vides en haut du terrain.
+ */
+static void positionsLibres(Modele *modele, const Rotation *r, uint64_t *libres, int16_t haut,
+                            int16_t vides) {
+  uint64_t occupees, partout;
+  int16_t y = 0, dy[NB_CASES_FORME], dx[NB_CASES_FORME];
+  // La boîte ne tient nulle part si elle est plus large que le terrain
+  if (r->larg > modele->nbColonnes) {
+    memset(libres, 0, haut * sizeof(uint64_t));
+    return;
+  }
+  // On garde les positions où la boîte ne deborde pas à droite
+  partout = (2ULL << (modele->nbColonnes - r->larg)) - 1;
+  for (; y < haut && y + r->haut <= vides; y++)
+    libres[y] = partout;
+  for (int k = 0; k < NB_CASES_FORME; k++)
+    dx[k] = r->cases[k].x - r->xMin, dy[k] = r->cases[k].y - r->yMin;
+  // Une position est occupée si l'une des cases de la forme tombe sur une case occupée
+  for (; y < haut; y++) {
+    occupees = 0;
+    for (int k = 0; k < NB_CASES_FORME; k++)
+      occupees |= modele->lignes[y + dy[k]] >> dx[k];
+    libres[y] = ~occupees & partout;
+  }
+}
+
+/**
+ * @brief Étend un ensemble de positions d'une ligne vers la gauche et vers la droite tant que les
+ * positions traversées sont libres (remplissage par doublement en 6 étapes).
+ * @param m représente les positions de départ.
+ * @param libres représente les positions libres de la ligne.
+ * @return les positions atteignables par décalages.
+ */
+static inline uint64_t etendLigne(uint64_t m, uint64_t libres) {
+  uint64_t d = m & libres, pd = libres, g = d, pg = libres;
+  for (int k = 1; k < 64; k <<= 1) {
+    d |= pd & (d << k), pd &= pd << k;
+    g |= pg & (g >> k), pg &= pg >> k;
+  }
+  return d | g;
+}
+
+/**
+ * @brief Implémentation de la fonction enumerePlacements.
+ */
+uint16_t enumerePlacements(Modele *modele, Placement *placements, uint16_t max) {
+  uint64_t libres[NB_ROTATIONS][MAX_LIGNES + 1], atteintes[NB_ROTATIONS][MAX_LIGNES];
+  uint64_t vues[NB_ROTATIONS][MAX_LIGNES], m, l, dessus, finales;
+  const Rotation *rots[NB_ROTATIONS];
+  int16_t hauts[NB_ROTATIONS], changees[NB_ROTATIONS], dx, dy, y, vides;
+  uint8_t r, p, e, gauche, droite;
+  uint16_t nb = 0;
+  Forme *forme = &modele->forme;
+
+  // On compte les lignes vides en haut du terrain
+  for (vides = 0; vides < modele->nbLignes && !modele->lignes[vides]; vides++)
+    ;
+  // On calcule les positions libres de chaque état de rotation, ligne par ligne (un état
+  // équivalent à un précédent a les mêmes)
+  for (r = 0; r < NB_ROTATIONS; r++) {
+    rots[r] = getRotation(forme->id, r);
+    hauts[r] = modele->nbLignes - rots[r]->haut + 1;
+    if (rots[r]->equivalente != r)
+      memcpy(libres[r], libres[rots[r]->equivalente], hauts[r] * sizeof(uint64_t));
+    else
+      positionsLibres(modele, rots[r], libres[r], hauts[r], vides);
+    libres[r][hauts[r]] = 0;
+    memset(atteintes[r], 0, hauts[r] * sizeof(uint64_t));
+  }
+
+  // On part de la position de la forme courante, qui doit être libre (sa boîte en (dx, dy))
+  r = forme->rotation;
+  dx = forme->x0 + rots[r]->xMin, dy = forme->y0 + rots[r]->yMin;
+  if (dx < 0 || dx >= modele->nbColonnes || (uint16_t)dy >= hauts[r] ||
+      !((libres[r][dy] >> dx) & 1))
+    return 0;
+  atteintes[r][dy] = 1ULL << dx;
+
+  // On propage les positions atteintes en faisant le tour des rotations jusqu'à ce que plus rien
+  // ne change. Une rotation ne reprend qu'à partir des lignes que la précédente a changées depuis
+  // (au premier tour, toutes les lignes sont à regarder)
+  for (r = 0; r < NB_ROTATIONS; r++)
+    changees[r] = -MAX_LIGNES;
+  for (r = forme->rotation;; r = (r + 1) % NB_ROTATIONS) {
+    p = (r + NB_ROTATIONS - 1) % NB_ROTATIONS;
+    if (changees[p] == INT16_MAX)
+      break;
+    // La rotation garde l'origine : la boîte se déplace de la différence des coins
+    dx = rots[r]->xMin - rots[p]->xMin, dy = rots[r]->yMin - rots[p]->yMin;
+    gauche = dx > 0 ? dx : 0, droite = dx < 0 ? -dx : 0;
+    y = changees[p] + dy > 0 ? changees[p] + dy : 0;
+    changees[p] = INT16_MAX;
+    for (dessus = y > 0 ? atteintes[r][y - 1] : 0; y < hauts[r]; y++, dessus = m) {
+      l = libres[r][y];
+      // En descendant depuis la ligne du dessus
+      m = atteintes[r][y] | (dessus & l);
+      // En tournant depuis l'état précédent
+      if ((uint16_t)(y - dy) < hauts[p])
+        m |= (atteintes[p][y - dy] << gauche >> droite) & l;
+      // En se décalant sur la ligne
+      if (!m)
+        continue;
+      if (m != l)
+        m = etendLigne(m, l);
+      if (m != atteintes[r][y]) {
+        atteintes[r][y] = m;
+        if (changees[r] > y)
+          changees[r] = y;
+      }
+    }
+  }
+
+  // Les placements finaux sont les positions atteintes qui ne peuvent plus descendre
+  for (r = 0; r < NB_ROTATIONS; r++) {
+    // On ne garde pas ceux déjà donnés par un état de rotation équivalent (qui vient avant)
+    e = rots[r]->equivalente, dx = rots[r]->xMin, dy = rots[r]->yMin;
+    for (y = 0; y < hauts[r]; y++) {
+      finales = atteintes[r][y] & ~libres[r][y + 1];
+      if (e == r)
+        vues[r][y] = finales;
+      else {
+        finales &= ~vues[e][y];
+        vues[e][y] |= finales;
+      }
+      for (; finales && nb < max; finales &= finales - 1)
+        placements[nb++] = (Placement){r, __builtin_ctzll(finales) - dx, y - dy};
+    }
+  }
+  return nb;
+}
+
+/**
+ * @brief Implémentation de la fonction cheminPlacement.
+ */
+int16_t cheminPlacement(Modele *modele,
+                        const Placement *placement,
+                        Mouvement *mouvements,
+                        uint16_t max) {
+  uint16_t nbL = getNbLignes(modele), nbC = getNbColonnes(modele);
+  uint16_t nbEtats = NB_ROTATIONS * nbL * nbC, parents[nbEtats], file[nbEtats];
+  uint16_t debut = 0, fin = 0, e, s, cible;
+  uint8_t coups[nbEtats], r, rs;
+  int16_t x, y, xs, ys, nb;
+  const Rotation *rot;
+  Forme *forme = &modele->forme;
+  // Un état est numéroté à partir de sa rotation et du coin de sa boîte
+#define ETAT(r, x, y) (((r) * nbL + (y)) * nbC + (x))
+
+  // On part de la position de la forme courante
+  memset(parents, 0xff, sizeof(parents));
+  rot = getRotation(forme->id, forme->rotation);
+  x = forme->x0 + rot->xMin, y = forme->y0 + rot->yMin;
+  if (!positionValide(modele, rot, x, y))
+    return -1;
+  s = ETAT(forme->rotation, x, y);
+  parents[s] = s, file[fin++] = s;
+  rot = getRotation(forme->id, placement->rotation);
+  cible = ETAT(placement->rotation, placement->x0 + rot->xMin, placement->y0 + rot->yMin);
+
+  // Parcours en largeur des états atteignables
+  while (debut < fin && parents[cible] == 0xffff) {
+    e = file[debut++];
+    r = e / (nbL * nbC), y = e / nbC % nbL, x = e % nbC;
+    for (Mouvement m = GAUCHE; m <= DESCEND; m++) {
+      rs = r, xs = x, ys = y;
+      if (m == GAUCHE)
+        xs--;
+      else if (m == DROITE)
+        xs++;
+      else if (m == DESCEND)
+        ys++;
+      else {
+        rs = (r + 1) % NB_ROTATIONS;
+        xs += getRotation(forme->id, rs)->xMin - getRotation(forme->id, r)->xMin;
+        ys += getRotation(forme->id, rs)->yMin - getRotation(forme->id, r)->yMin;
+      }
+      if (!positionValide(modele, getRotation(forme->id, rs), xs, ys))
+        continue;
+      s = ETAT(rs, xs, ys);
+      if (parents[s] == 0xffff)
+        parents[s] = e, coups[s] = m, file[fin++] = s;
+    }
+  }
+#undef ETAT
+  if (parents[cible] == 0xffff)
+    return -1;
+
+  // On remonte le chemin depuis la cible
+  for (nb = 0, s = cible; parents[s] != s; s = parents[s])
+    nb++;
+  if (nb > max)
+    return -1;
+  for (e = nb, s = cible; parents[s] != s; s = parents[s])
+    mouvements[--e] = coups[s];
+  return nb;
+}
+
+/**
+ * @brief Implémentation de la fonction joueMouvement.
+ */
+int8_t joueMouvement(Modele *modele, Mouvement mouvement) {
+  switch (mouvement) {
+    case GAUCHE :
+      formeDecaleGauche(modele);
+      return 0;
+    case DROITE :
+      formeDecaleDroite(modele);
+      return 0;
+    case TOURNE :
+      formeTourne(modele);
+      return 0;
+    default :
+      return formeAvance(modele);
+  }
+}
+
+/**
+ * @brief Implémentation de la fonction joueMouvements.
+ */
+int8_t joueMouvements(Modele *modele, const Mouvement *mouvements, uint16_t nb) {
+  for (uint16_t i = 0; i < nb; i++)
+    joueMouvement(modele, mouvements[i]);
+  // La forme est au bout du chemin, on la dépose
+  return formeAvance(modele);
+}
@@ -0,0 +1,60 @@
+#ifndef PLACEMENT_H
+#define PLACEMENT_H
+
+#include "modele.h"
+
+// Macro pour une taille de tableau suffisante pour tous les placements d'une forme
+#define MAX_PLACEMENTS 1024
+
+// Structure d'un placement final de la forme courante : son état de rotation et son origine
+typedef struct placement {
+  uint8_t rotation;
+  int16_t x0, y0;
+} Placement;
+
+// Énumération des mouvements élémentaires qui mènent la forme courante à un placement
+typedef enum mouvement { GAUCHE = 0, DROITE, TOURNE, DESCEND } Mouvement;
+
+/**
+ * @brief Énumère tous les placements finaux atteignables par la forme courante depuis sa position
+ * à l'aide de décalages, de rotations et de descentes (y compris sous les surplombs). Les
+ * placements qui occupent les mêmes cases ne sont donnés qu'une fois. Le calcul se fait sur les
+ * masques des lignes (une ligne de positions à la fois) et n'alloue rien.
+ * @param modele représente le modèle du jeu contenant la forme courante.
+ * @param placements représente un tableau où stocker les placements. (Paramètre modifié)
+ * @param max représente la taille du tableau (MAX_PLACEMENTS suffit).
+ * @return le nombre de placements stockés.
+ */
+uint16_t enumerePlacements(Modele *modele, Placement *placements, uint16_t max);
+
+/**
+ * @brief Cherche la plus courte suite de mouvements qui mène la forme courante à un placement.
+ * @param modele représente le modèle du jeu contenant la forme courante.
+ * @param placement représente le placement à atteindre.
+ * @param mouvements représente un tableau où stocker les mouvements. (Paramètre modifié)
+ * @param max représente la taille du tableau.
+ * @return le nombre de mouvements ou -1 si le placement n'est pas atteignable.
+ */
+int16_t cheminPlacement(Modele *modele,
+                        const Placement *placement,
+                        Mouvement *mouvements,
+                        uint16_t max);
+
+/**
+ * @brief Joue un mouvement élémentaire avec les fonctions du modèle.
+ * @param modele représente le modèle du jeu. (Paramètre modifié)
+ * @param mouvement représente le mouvement à jouer.
+ * @return 1 si la forme a été déposée en descendant et 0 si non.
+ */
+int8_t joueMouvement(Modele *modele, Mouvement mouvement);
+
+/**
+ * @brief Joue une suite de mouvements avec les fonctions du modèle puis dépose la forme courante.
+ * @param modele représente le modèle du jeu. (Paramètre modifié)
+ * @param mouvements représente les mouvements à jouer.
+ * @param nb représente le nombre de mouvements.
+ * @return 1 si la forme a été déposée et 0 si non.
+ */
+int8_t joueMouvements(Modele *modele, const Mouvement *mouvements, uint16_t nb);
+
+#endif
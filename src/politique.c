@@ -0,0 +1,112 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "forme.h"
+#include "ia.h"
+#include "politique.h"
+
+// Macro pour le nombre de pièces par défaut d'une partie de l'IA (elle ne perd presque jamais)
+#define MAX_PIECES_FAISCEAU 1000
+
+/**
+ * @brief Crée l'état de la politique aléatoire : un générateur propre à la partie.
+ */
+static void *creeEtatAleatoire(Modele *modele, uint64_t graine) {
+  Alea *alea = (Alea *)malloc(sizeof(Alea));
+  if (alea)
+    initAlea(alea, graine);
+  return alea;
+}
+
+/**
+ * @brief Joue une rotation et une colonne choisies au hasard.
+ */
+static void joueAleatoire(Modele *modele, void *etat) {
+  Coup coup;
+  coup.rotation = tireAlea((Alea *)etat, NB_ROTATIONS);
+  coup.x = tireAlea((Alea *)etat, getNbColonnes(modele));
+  joueCoup(modele, &coup);
+}
+
+/**
+ * @brief Crée l'état de la politique de l'IA : l'IA elle même (la graine ne sert pas).
+ */
+static void *creeEtatFaisceau(Modele *modele, uint64_t graine) {
+  return initIA(LARGEUR_FAISCEAU);
+}
+
+/**
+ * @brief Joue le chemin vers le placement choisi par l'IA ou fait tomber la forme si il n'y en a pas.
+ */
+static void joueFaisceau(Modele *modele, void *etat) {
+  Mouvement mouvements[MAX_PLACEMENTS];
+  Placement placement;
+  int16_t nb = -1;
+  if (!choisitPlacementIA((IA *)etat, modele, &placement))
+    nb = cheminPlacement(modele, &placement, mouvements, MAX_PLACEMENTS);
+  if (nb < 0)
+    formeChute(modele);
+  else
+    joueMouvements(modele, mouvements, nb);
+}
+
+/**
+ * @brief Détruit l'état de la politique de l'IA.
+ */
+static void detruitEtatFaisceau(void *etat) {
+  detruitIA((IA *)etat);
+}
+
+// Liste des politiques disponibles
+static const Politique LES_POLITIQUES[] = {
+    {"aleatoire", creeEtatAleatoire, joueAleatoire, free, 0},
+    {"faisceau", creeEtatFaisceau, joueFaisceau, detruitEtatFaisceau, MAX_PIECES_FAISCEAU},
+};
+
+/**
+ * @brief Implémentation de la fonction trouvePolitique.
+ */
+const Politique *trouvePolitique(const char *nom) {
+  for (size_t i = 0; i < sizeof(LES_POLITIQUES) / sizeof(Politique); i++)
+    if (!strcmp(LES_POLITIQUES[i].nom, nom))
+      return &LES_POLITIQUES[i];
+  return NULL;
+}
+
+/**
+ * @brief Décale la forme courante d'une case vers la colonne voulue.
+ * @param modele représente le modèle du jeu. (Paramètre modifié)
+ * @param x représente la colonne d'origine voulue.
+ * @return 1 si la forme s'est décalée et 0 si non.
+ */
+static uint8_t decaleVers(Modele *modele, int16_t x) {
+  int16_t x0 = modele->forme.x0;
+  if (x0 < x)
+    formeDecaleDroite(modele);
+  else if (x0 > x)
+    formeDecaleGauche(modele);
+  return modele->forme.x0 != x0;
+}
+
+/**
+ * @brief Implémentation de la fonction joueCoup.
+ */
+int8_t joueCoup(Modele *modele, const Coup *coup) {
+  uint8_t r;
+  // On tourne la forme
+  for (int i = 0; i < coup->rotation; i++) {
+    r = modele->forme.rotation;
+    formeTourne(modele);
+    if (modele->forme.rotation != r)
+      continue;
+    // Si elle ne peut pas tourner (contre un bord ou en haut du terrain), on la rapproche de la
+    // colonne voulue ou on la fait descendre d'une case avant de réessayer
+    if (decaleVers(modele, coup->x) || (getDistanceChute(modele) > 0 && !formeAvance(modele)))
+      i--;
+  }
+  // On la décale tant qu'elle avance vers la colonne voulue
+  while (decaleVers(modele, coup->x))
+    ;
+  // On la fait tomber
+  return formeChute(modele);
+}
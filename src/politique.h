@@ -0,0 +1,43 @@
+#ifndef POLITIQUE_H
+#define POLITIQUE_H
+
+#include "modele.h"
+
+// Structure d'un coup : la rotation et la colonne d'origine voulues pour la forme courante
+typedef struct coup {
+  uint8_t rotation;
+  int16_t x;
+} Coup;
+
+// Structure d'une politique de jeu qui joue la forme courante jusqu'à son dépôt
+typedef struct politique {
+  const char *nom;
+  // Crée l'état de la politique pour une partie (peut être NULL si elle n'en a pas besoin)
+  void *(*creeEtat)(Modele *modele, uint64_t graine);
+  // Joue la forme courante du modèle jusqu'à son dépôt
+  void (*joue)(Modele *modele, void *etat);
+  // Détruit l'état de la politique (peut être NULL)
+  void (*detruitEtat)(void *etat);
+  // Nombre de pièces par partie par défaut (0 si ses parties finissent d'elles mêmes). Une
+  // politique qui ne perd presque jamais doit en avoir un, sinon ses parties ne finissent pas
+  uint32_t maxPieces;
+} Politique;
+
+/**
+ * @brief Cherche une politique parmi celles disponibles.
+ * @param nom représente le nom de la politique.
+ * @return un pointeur vers la politique ou NULL si elle n'existe pas.
+ */
+const Politique *trouvePolitique(const char *nom);
+
+/**
+ * @brief Joue un coup avec les fonctions du modèle : tourne la forme courante, la décale vers la
+ * colonne voulue puis la fait tomber. Quand elle ne peut pas tourner, la forme se rapproche d'abord de
+ * la colonne voulue ou descend. Elle s'arrête si elle est bloquée en chemin.
+ * @param modele représente le modèle du jeu. (Paramètre modifié)
+ * @param coup représente le coup à jouer.
+ * @return 1 car la forme est déposée à la fin du coup.
+ */
+int8_t joueCoup(Modele *modele, const Coup *coup);
+
+#endif
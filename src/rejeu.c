@@ -0,0 +1,737 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "forme.h"
+#include "rejeu.h"
+
+// Macro pour la signature au début des fichiers de rejeu (avec le numéro de version)
+#define SIGNATURE "TRJ\3"
+// Macro pour la signature à la fin de l'index des instantanés
+#define SIGNATURE_INDEX "TRJI"
+// Macro pour le nombre de bits de l'évènement dans un enregistrement
+#define BITS_EVENEMENT 4
+// Macro pour le code d'un instantané à la place de l'évènement dans un enregistrement
+#define CODE_INSTANTANE 15
+// Macro pour la taille d'un repère dans l'index (tour sur 4 octets et position sur 8)
+#define TAILLE_REPERE 12
+// Macro pour la longueur minimale d'une suite d'octets égaux compressée
+#define MIN_SUITE 4
+// Macro pour le nombre d'entiers variables au plus avant le terrain compressé d'un instantané (9
+// pour la partie, 18 pour les valeurs et les formes du modèle, une ligne d'occupation par ligne et
+// le nombre de cases)
+#define MAX_CHAMPS (9 + 18 + MAX_LIGNES + 1)
+
+/**
+ * @brief Écrit des octets dans le fichier du rejeu.
+ * @param rejeu représente le rejeu créé. (Paramètre modifié)
+ * @param octets représente les octets à écrire.
+ * @param n représente le nombre d'octets.
+ */
+static void ecritOctets(Rejeu *rejeu, const void *octets, size_t n) {
+  fwrite(octets, 1, n, rejeu->fichier);
+  rejeu->position += n;
+}
+
+/**
+ * @brief Lit un octet du rejeu (dans le fichier ou en mémoire) sans dépasser la fin des évènements.
+ * @param rejeu représente le rejeu ouvert. (Paramètre modifié)
+ * @return l'octet lu ou EOF si on est à la fin.
+ */
+static int lisOctet(Rejeu *rejeu) {
+  int c;
+  if (rejeu->position >= rejeu->fin)
+    return EOF;
+  if (rejeu->octets)
+    return rejeu->octets[rejeu->position++];
+  if ((c = fgetc(rejeu->fichier)) == EOF)
+    return EOF;
+  rejeu->position++;
+  return c;
+}
+
+/**
+ * @brief Prend des octets du rejeu sans dépasser la fin des évènements. En mémoire, ils ne sont
+ * pas copiés et si non ils sont lus dans un tampon.
+ * @param rejeu représente le rejeu ouvert. (Paramètre modifié)
+ * @param tampon représente le tampon où lire depuis le fichier. (Paramètre modifié)
+ * @param n représente le nombre d'octets.
+ * @return les octets ou NULL si il n'y en a pas assez.
+ */
+static const uint8_t *prendOctets(Rejeu *rejeu, void *tampon, size_t n) {
+  const uint8_t *octets = (const uint8_t *)tampon;
+  if (n > rejeu->fin - rejeu->position)
+    return NULL;
+  if (rejeu->octets)
+    octets = rejeu->octets + rejeu->position;
+  else if (fread(tampon, 1, n, rejeu->fichier) != n)
+    return NULL;
+  rejeu->position += n;
+  return octets;
+}
+
+/**
+ * @brief Place la lecture du rejeu à une position.
+ * @param rejeu représente le rejeu ouvert. (Paramètre modifié)
+ * @param position représente la position depuis le début (pas après la fin du rejeu).
+ * @return 0 si tous s'est bien passée et -1 si non.
+ */
+static int8_t placeRejeu(Rejeu *rejeu, uint64_t position) {
+  if (position > rejeu->taille ||
+      (!rejeu->octets && fseek(rejeu->fichier, position, SEEK_SET)))
+    return -1;
+  rejeu->position = position;
+  return 0;
+}
+
+/**
+ * @brief Écrit un entier non signé en petit boutiste sur un nombre d'octets donné.
+ * @param rejeu représente le rejeu créé. (Paramètre modifié)
+ * @param valeur représente l'entier à écrire.
+ * @param nbOctets représente le nombre d'octets.
+ */
+static void ecritEntier(Rejeu *rejeu, uint64_t valeur, int nbOctets) {
+  uint8_t octets[8];
+  for (int i = 0; i < nbOctets; i++)
+    octets[i] = (valeur >> (8 * i)) & 0xff;
+  ecritOctets(rejeu, octets, nbOctets);
+}
+
+/**
+ * @brief Lit un entier non signé en petit boutiste sur un nombre d'octets donné.
+ * @param rejeu représente le rejeu ouvert. (Paramètre modifié)
+ * @param valeur représente l'espace où stocker l'entier. (Paramètre modifié)
+ * @param nbOctets représente le nombre d'octets.
+ * @return 0 si tous s'est bien passée et -1 si le fichier est fini.
+ */
+static int8_t lisEntier(Rejeu *rejeu, uint64_t *valeur, int nbOctets) {
+  int c;
+  *valeur = 0;
+  for (int i = 0; i < nbOctets; i++) {
+    if ((c = lisOctet(rejeu)) == EOF)
+      return -1;
+    *valeur |= (uint64_t)c << (8 * i);
+  }
+  return 0;
+}
+
+/**
+ * @brief Met un entier variable dans un tampon : 7 bits par octet, le bit de poids fort indique
+ * qu'il y'a un octet de plus.
+ * @param tampon représente le tampon (au moins 10 octets libres). (Paramètre modifié)
+ * @param valeur représente l'entier à mettre.
+ * @return le nombre d'octets utilisés.
+ */
+static size_t metVariable(uint8_t *tampon, uint64_t valeur) {
+  size_t n = 0;
+  for (; valeur >= 0x80; valeur >>= 7)
+    tampon[n++] = (valeur & 0x7f) | 0x80;
+  tampon[n++] = valeur;
+  return n;
+}
+
+/**
+ * @brief Prend un entier variable dans un tampon.
+ * @param p représente la position dans le tampon, avancée après l'entier. (Paramètre modifié)
+ * @param fin représente la fin du tampon.
+ * @param valeur représente l'espace où stocker l'entier. (Paramètre modifié)
+ * @return 0 si tous s'est bien passée et -1 si le tampon est fini ou l'entier trop long.
+ */
+static int8_t prendVariable(const uint8_t **p, const uint8_t *fin, uint64_t *valeur) {
+  *valeur = 0;
+  for (int decalage = 0; decalage < 64 && *p < fin; decalage += 7) {
+    *valeur |= (uint64_t)(**p & 0x7f) << decalage;
+    if (!(*(*p)++ & 0x80))
+      return 0;
+  }
+  return -1;
+}
+
+/**
+ * @brief Écrit un entier variable dans le fichier du rejeu.
+ * @param rejeu représente le rejeu créé. (Paramètre modifié)
+ * @param valeur représente l'entier à écrire.
+ */
+static void ecritVariable(Rejeu *rejeu, uint64_t valeur) {
+  uint8_t octets[10];
+  ecritOctets(rejeu, octets, metVariable(octets, valeur));
+}
+
+/**
+ * @brief Lit un entier variable du fichier du rejeu.
+ * @param rejeu représente le rejeu ouvert. (Paramètre modifié)
+ * @param valeur représente l'espace où stocker l'entier. (Paramètre modifié)
+ * @return 0 si tous s'est bien passée et -1 si les évènements sont finis ou l'entier trop long.
+ */
+static int8_t lisVariable(Rejeu *rejeu, uint64_t *valeur) {
+  int c;
+  *valeur = 0;
+  for (int decalage = 0; decalage < 64; decalage += 7) {
+    if ((c = lisOctet(rejeu)) == EOF)
+      return -1;
+    *valeur |= (uint64_t)(c & 0x7f) << decalage;
+    if (!(c & 0x80))
+      return 0;
+  }
+  return -1;
+}
+
+/**
+ * @brief Compresse un bloc : les suites d'au moins MIN_SUITE octets égaux sont mises sur un
+ * entier variable (longueur * 2 + 1) et l'octet, les autres octets sur un entier variable
+ * (longueur * 2) et les octets tels quels.
+ * @param bloc représente le bloc à compresser.
+ * @param taille représente la taille du bloc.
+ * @param tampon représente le tampon (au moins taille + 10 octets). (Paramètre modifié)
+ * @return la taille du bloc compressé.
+ */
+static size_t compresse(const uint8_t *bloc, size_t taille, uint8_t *tampon) {
+  size_t i = 0, j, debut, n = 0;
+  while (i < taille) {
+    // On cherche la fin de la suite d'octets égaux qui commence en i
+    for (j = i + 1; j < taille && bloc[j] == bloc[i]; j++)
+      ;
+    if (j - i >= MIN_SUITE) {
+      n += metVariable(tampon + n, (j - i) << 1 | 1);
+      tampon[n++] = bloc[i];
+      i = j;
+      continue;
+    }
+    // Si non on garde les octets tels quels jusqu'à la prochaine suite
+    for (debut = i; i < taille; i++) {
+      for (j = i + 1; j < taille && j - i < MIN_SUITE && bloc[j] == bloc[i]; j++)
+        ;
+      if (j - i >= MIN_SUITE)
+        break;
+    }
+    n += metVariable(tampon + n, (i - debut) << 1);
+    memcpy(tampon + n, bloc + debut, i - debut);
+    n += i - debut;
+  }
+  return n;
+}
+
+/**
+ * @brief Décompresse un bloc compressé par compresse.
+ * @param p représente le début du bloc compressé.
+ * @param fin représente la fin du bloc compressé.
+ * @param bloc représente l'espace où décompresser. (Paramètre modifié)
+ * @param taille représente la taille du bloc décompressé.
+ * @return 0 si tous s'est bien passée et -1 si le bloc compressé est abîmé.
+ */
+static int8_t decompresse(const uint8_t *p, const uint8_t *fin, uint8_t *bloc, size_t taille) {
+  uint64_t valeur, n;
+  size_t i = 0;
+  while (i < taille) {
+    if (prendVariable(&p, fin, &valeur))
+      return -1;
+    n = valeur >> 1;
+    if (n > taille - i)
+      return -1;
+    if (valeur & 1) {
+      if (p >= fin)
+        return -1;
+      memset(bloc + i, *p++, n);
+    } else {
+      if (n > (uint64_t)(fin - p))
+        return -1;
+      memcpy(bloc + i, p, n);
+      p += n;
+    }
+    i += n;
+  }
+  return p == fin ? 0 : -1;
+}
+
+// Macro pour la taille du tampon des instantanés d'un modèle de taille donnée
+#define TAILLE_TAMPON(taille) (10 * MAX_CHAMPS + 2 * (taille))
+
+/**
+ * @brief Met une forme dans un tampon : numéro, rotation, origine et couleur.
+ * @param tampon représente le tampon. (Paramètre modifié)
+ * @param forme représente la forme.
+ * @return le nombre d'octets utilisés.
+ */
+static size_t metForme(uint8_t *tampon, const Forme *forme) {
+  size_t n = 0;
+  n += metVariable(tampon + n, forme->id);
+  n += metVariable(tampon + n, forme->rotation);
+  n += metVariable(tampon + n, (uint16_t)forme->x0);
+  n += metVariable(tampon + n, (uint16_t)forme->y0);
+  n += metVariable(tampon + n, forme->couleur);
+  return n;
+}
+
+/**
+ * @brief Prend une forme dans un tampon (ses valeurs sont vérifiées par reconstruitModele).
+ * @param p représente la position dans le tampon, avancée après la forme. (Paramètre modifié)
+ * @param fin représente la fin du tampon.
+ * @param forme représente l'espace où stocker la forme. (Paramètre modifié)
+ * @return 0 si tous s'est bien passée et -1 si le tampon est fini ou une valeur trop grande.
+ */
+static int8_t prendForme(const uint8_t **p, const uint8_t *fin, Forme *forme) {
+  uint64_t champs[5];
+  for (int i = 0; i < 5; i++)
+    if (prendVariable(p, fin, &champs[i]) || champs[i] > UINT16_MAX)
+      return -1;
+  if (champs[0] > UINT8_MAX || champs[1] > UINT8_MAX)
+    return -1;
+  forme->id = champs[0], forme->rotation = champs[1];
+  forme->x0 = (int16_t)champs[2], forme->y0 = (int16_t)champs[3];
+  forme->couleur = champs[4];
+  return 0;
+}
+
+/**
+ * @brief Met les valeurs d'un modèle dans un tampon, champ par champ pour ne pas dépendre de la
+ * disposition de la structure : score, délai, coefficient, générateur, formes, lignes supprimées,
+ * occupation des lignes puis le terrain compressé. Le reste se recalcule à la lecture.
+ * @param tampon représente le tampon (au moins TAILLE_TAMPON(getTailleModele(modele)) octets).
+ * (Paramètre modifié)
+ * @param modele représente le modèle.
+ * @return le nombre d'octets utilisés.
+ */
+static size_t metModele(uint8_t *tampon, Modele *modele) {
+  size_t n = 0, nbCases = modele->nbLignes * modele->nbColonnes;
+  int i;
+  n += metVariable(tampon + n, modele->score);
+  n += metVariable(tampon + n, modele->delai);
+  n += metVariable(tampon + n, modele->coef);
+  for (i = 0; i < 4; i++)
+    n += metVariable(tampon + n, modele->alea.s[i]);
+  n += metForme(tampon + n, &modele->forme);
+  n += metForme(tampon + n, &modele->suivante);
+  n += metVariable(tampon + n, modele->lignesSupprimees);
+  for (i = 0; i < modele->nbLignes; i++)
+    n += metVariable(tampon + n, modele->lignes[i]);
+  n += metVariable(tampon + n, nbCases);
+  n += compresse(modele->terrain, nbCases, tampon + n);
+  return n;
+}
+
+/**
+ * @brief Prend les valeurs d'un modèle enregistrées par ecritInstantane dans un tampon, puis le
+ * terrain compressé.
+ * @param p représente la position dans le tampon. (Paramètre modifié)
+ * @param fin représente la fin du tampon.
+ * @param modele représente le modèle à remplir, avec ses dimensions. (Paramètre modifié)
+ * @return 0 si tous s'est bien passée et -1 si l'instantané est abîmé.
+ */
+static int8_t prendModele(const uint8_t **p, const uint8_t *fin, Modele *modele) {
+  uint64_t champs[3], nbCases;
+  int i;
+  for (i = 0; i < 3; i++)
+    if (prendVariable(p, fin, &champs[i]) || champs[i] > (i ? UINT16_MAX : UINT32_MAX))
+      return -1;
+  modele->score = champs[0], modele->delai = champs[1], modele->coef = champs[2];
+  for (i = 0; i < 4; i++)
+    if (prendVariable(p, fin, &modele->alea.s[i]))
+      return -1;
+  if (prendForme(p, fin, &modele->forme) || prendForme(p, fin, &modele->suivante) ||
+      prendVariable(p, fin, &modele->lignesSupprimees))
+    return -1;
+  memset(modele->lignes, 0, sizeof(modele->lignes));
+  for (i = 0; i < modele->nbLignes; i++)
+    if (prendVariable(p, fin, &modele->lignes[i]))
+      return -1;
+  nbCases = modele->nbLignes * modele->nbColonnes;
+  if (prendVariable(p, fin, &champs[0]) || champs[0] != nbCases ||
+      decompresse(*p, fin, modele->terrain, nbCases))
+    return -1;
+  return reconstruitModele(modele);
+}
+
+/**
+ * @brief Prépare le tampon et le bloc des instantanés pour un modèle d'une taille donnée.
+ * @param rejeu représente le rejeu. (Paramètre modifié)
+ * @param taille représente la taille du modèle.
+ * @return 0 si tous s'est bien passée et -1 si non.
+ */
+static int8_t prepareInstantane(Rejeu *rejeu, size_t taille) {
+  uint8_t *tampon, *instantane;
+  if (rejeu->tailleInstantane == taille)
+    return 0;
+  // Le tampon a la place pour les champs (10 octets au plus chacun) et le terrain compressé
+  tampon = (uint8_t *)realloc(rejeu->tampon, TAILLE_TAMPON(taille));
+  if (tampon)
+    rejeu->tampon = tampon;
+  instantane = (uint8_t *)realloc(rejeu->instantane, taille);
+  if (instantane)
+    rejeu->instantane = instantane;
+  if (!tampon || !instantane) {
+    perror("Erreur à l'instantané du rejeu : Allocation mémoire échouée");
+    return -1;
+  }
+  rejeu->tailleInstantane = taille;
+  return 0;
+}
+
+/**
+ * @brief Lit un instantané à la position du fichier et y remet la partie.
+ * @param rejeu représente le rejeu ouvert. (Paramètre modifié)
+ * @param partie représente la partie. (Paramètre modifié)
+ * @return 0 si tous s'est bien passée et -1 si non.
+ */
+static int8_t lisInstantane(Rejeu *rejeu, Partie *partie) {
+  uint64_t taille, champs[8];
+  const uint8_t *p, *fin;
+  Modele *modele;
+  if (prepareInstantane(rejeu, getTailleModele(partie->modele)))
+    return -1;
+  // Lecture de l'instantané compressé
+  if (lisVariable(rejeu, &taille) || taille > TAILLE_TAMPON(rejeu->tailleInstantane) ||
+      !(p = prendOctets(rejeu, rejeu->tampon, taille))) {
+    fprintf(stderr, "Erreur à la lecture du rejeu : Instantané incomplet\n");
+    return -1;
+  }
+  fin = p + taille;
+  // Lecture de l'état de la partie puis du modèle, dans une copie du modèle de la partie (qui
+  // garde ses dimensions et sa graine) pour ne pas la toucher si l'instantané est abîmé
+  modele = (Modele *)rejeu->instantane;
+  memcpy(modele, partie->modele, rejeu->tailleInstantane);
+  for (int i = 0; i < 8; i++)
+    if (prendVariable(&p, fin, &champs[i]) || champs[i] > UINT16_MAX) {
+      fprintf(stderr, "Erreur à la lecture du rejeu : Instantané abîmé\n");
+      return -1;
+    }
+  if (champs[5] >= NB_ROTATIONS || prendModele(&p, fin, modele) ||
+      restaureModele(partie->modele, modele)) {
+    fprintf(stderr, "Erreur à la lecture du rejeu : Instantané abîmé\n");
+    return -1;
+  }
+  partie->tour = rejeu->dernierTour;
+  partie->nbAppel = champs[0], partie->delai = champs[1];
+  partie->estEnPause = champs[2], partie->estTermine = champs[3];
+  partie->aCible = champs[4], partie->cible.rotation = champs[5];
+  partie->cible.x0 = (int16_t)champs[6], partie->cible.y0 = (int16_t)champs[7];
+  partie->aAfficher = 1, partie->errEtCollEvts = 0;
+  return 0;
+}
+
+/**
+ * @brief Lit le prochain évènement du rejeu et son tour en passant les instantanés.
+ * @param rejeu représente le rejeu ouvert. (Paramètre modifié)
+ */
+static void lisProchain(Rejeu *rejeu) {
+  uint64_t valeur, taille;
+  while (!lisVariable(rejeu, &valeur)) {
+    rejeu->tourProchain = rejeu->dernierTour + (valeur >> BITS_EVENEMENT);
+    rejeu->prochain = valeur & ((1 << BITS_EVENEMENT) - 1);
+    if (rejeu->prochain < RIEN)
+      return;
+    // On saute les instantanés, ils ne servent qu'à chercher un tour
+    if (rejeu->prochain == CODE_INSTANTANE && !lisVariable(rejeu, &taille) &&
+        taille <= rejeu->fin - rejeu->position && !placeRejeu(rejeu, rejeu->position + taille)) {
+      rejeu->dernierTour = rejeu->tourProchain;
+      continue;
+    }
+    // Un évènement inconnu ou un instantané tronqué veut dire que le rejeu est abîmé
+    fprintf(stderr, "Erreur à la lecture du rejeu : Enregistrement invalide\n");
+    break;
+  }
+  rejeu->estFini = 1;
+}
+
+/**
+ * @brief Lit l'index des instantanés à la fin du rejeu : les repères, leur nombre sur 4 octets
+ * puis la signature de l'index.
+ * @param rejeu représente le rejeu ouvert, placé après l'en-tête. (Paramètre modifié)
+ * @return 0 si il y'a un index valide et -1 si non.
+ */
+static int8_t lisIndex(Rejeu *rejeu) {
+  uint64_t debut = rejeu->position, nb, tour, fin;
+  const uint8_t *signature;
+  char tampon[4];
+  // Lecture du nombre de repères et de la signature
+  if (rejeu->taille < debut + 8 || placeRejeu(rejeu, rejeu->taille - 8) ||
+      lisEntier(rejeu, &nb, 4) || !(signature = prendOctets(rejeu, tampon, 4)) ||
+      memcmp(signature, SIGNATURE_INDEX, 4) || nb * TAILLE_REPERE > rejeu->taille - 8 - debut)
+    return -1;
+  // Lecture des repères, les évènements finissent là où ils commencent
+  fin = rejeu->taille - 8 - nb * TAILLE_REPERE;
+  if (placeRejeu(rejeu, fin))
+    return -1;
+  rejeu->reperes = (Repere *)malloc((nb ? nb : 1) * sizeof(Repere));
+  if (!rejeu->reperes) {
+    perror("Erreur à l'ouverture du rejeu : Allocation mémoire échouée");
+    return -1;
+  }
+  rejeu->capacite = nb;
+  for (; rejeu->nbReperes < nb; rejeu->nbReperes++) {
+    if (lisEntier(rejeu, &tour, 4) ||
+        lisEntier(rejeu, &rejeu->reperes[rejeu->nbReperes].position, 8))
+      return -1;
+    rejeu->reperes[rejeu->nbReperes].tour = tour;
+  }
+  rejeu->fin = fin;
+  return 0;
+}
+
+/**
+ * @brief Lit l'en-tête, l'index et le premier évènement d'un rejeu ouvert.
+ * @param rejeu représente le rejeu ouvert, placé au début. (Paramètre modifié)
+ * @return 0 si tous s'est bien passée et -1 si ce n'est pas un rejeu.
+ */
+static int8_t lisDebut(Rejeu *rejeu) {
+  uint64_t nbLignes, nbColonnes, avecIA, debut;
+  const uint8_t *signature;
+  char tampon[4];
+  // Lecture de l'en-tête
+  rejeu->fin = rejeu->taille;
+  if (!(signature = prendOctets(rejeu, tampon, 4)) || memcmp(signature, SIGNATURE, 4) ||
+      lisEntier(rejeu, &nbLignes, 2) || lisEntier(rejeu, &nbColonnes, 2) ||
+      lisEntier(rejeu, &rejeu->graine, 8) || lisEntier(rejeu, &avecIA, 1))
+    return -1;
+  // Les dimensions viennent du fichier, on les vérifie avant de créer un modèle avec
+  if (nbColonnes < MIN_COLONNES || nbColonnes > MAX_COLONNES || nbLignes < MIN_LIGNES ||
+      nbLignes + BASE > MAX_LIGNES)
+    return -1;
+  rejeu->nbLignes = nbLignes, rejeu->nbColonnes = nbColonnes, rejeu->avecIA = avecIA;
+  // Lecture de l'index (sans lui, les évènements vont jusqu'à la fin du rejeu)
+  debut = rejeu->position;
+  if (lisIndex(rejeu))
+    rejeu->nbReperes = 0, rejeu->fin = rejeu->taille;
+  if (placeRejeu(rejeu, debut))
+    return -1;
+  // Lecture du premier évènement
+  lisProchain(rejeu);
+  return 0;
+}
+
+/**
+ * @brief Implémentation de la fonction creeRejeu.
+ */
+Rejeu *creeRejeu(const char *chemin, uint16_t nbLignes, uint16_t nbColonnes, uint64_t graine,
+                 uint8_t avecIA) {
+  // Création du rejeu
+  Rejeu *rejeu = (Rejeu *)calloc(1, sizeof(Rejeu));
+  if (!rejeu) {
+    perror("Erreur à la création du rejeu : Allocation mémoire échouée");
+    return NULL;
+  }
+  // Création du fichier
+  rejeu->fichier = fopen(chemin, "wb");
+  if (!rejeu->fichier) {
+    perror("Erreur à la création du rejeu : Ouverture du fichier échouée");
+    free(rejeu);
+    return NULL;
+  }
+  rejeu->nbLignes = nbLignes, rejeu->nbColonnes = nbColonnes;
+  rejeu->graine = graine, rejeu->avecIA = avecIA;
+  rejeu->enEcriture = 1;
+  // Écriture de l'en-tête
+  ecritOctets(rejeu, SIGNATURE, 4);
+  ecritEntier(rejeu, nbLignes, 2);
+  ecritEntier(rejeu, nbColonnes, 2);
+  ecritEntier(rejeu, graine, 8);
+  ecritEntier(rejeu, avecIA, 1);
+  return rejeu;
+}
+
+/**
+ * @brief Implémentation de la fonction ouvreRejeu.
+ */
+Rejeu *ouvreRejeu(const char *chemin) {
+  long taille;
+  // Création du rejeu
+  Rejeu *rejeu = (Rejeu *)calloc(1, sizeof(Rejeu));
+  if (!rejeu) {
+    perror("Erreur à l'ouverture du rejeu : Allocation mémoire échouée");
+    return NULL;
+  }
+  // Ouverture du fichier
+  rejeu->fichier = fopen(chemin, "rb");
+  if (!rejeu->fichier) {
+    perror("Erreur à l'ouverture du rejeu : Ouverture du fichier échouée");
+    free(rejeu);
+    return NULL;
+  }
+  if (fseek(rejeu->fichier, 0, SEEK_END) || (taille = ftell(rejeu->fichier)) < 0 ||
+      fseek(rejeu->fichier, 0, SEEK_SET)) {
+    perror("Erreur à l'ouverture du rejeu");
+    fermeRejeu(rejeu);
+    return NULL;
+  }
+  rejeu->taille = taille;
+  // Lecture de l'en-tête
+  if (lisDebut(rejeu)) {
+    fprintf(stderr, "Erreur à l'ouverture du rejeu : %s n'est pas un fichier de rejeu\n", chemin);
+    fermeRejeu(rejeu);
+    return NULL;
+  }
+  return rejeu;
+}
+
+/**
+ * @brief Implémentation de la fonction ouvreRejeuMemoire.
+ */
+Rejeu *ouvreRejeuMemoire(const void *octets, size_t taille) {
+  // Création du rejeu
+  Rejeu *rejeu = (Rejeu *)calloc(1, sizeof(Rejeu));
+  if (!rejeu) {
+    perror("Erreur à l'ouverture du rejeu : Allocation mémoire échouée");
+    return NULL;
+  }
+  rejeu->octets = (const uint8_t *)octets, rejeu->taille = taille;
+  // Lecture de l'en-tête
+  if (lisDebut(rejeu)) {
+    fprintf(stderr, "Erreur à l'ouverture du rejeu : Ce n'est pas un rejeu\n");
+    fermeRejeu(rejeu);
+    return NULL;
+  }
+  return rejeu;
+}
+
+/**
+ * @brief Implémentation de la fonction ecritEvenement.
+ */
+int8_t ecritEvenement(Rejeu *rejeu, uint32_t tour, Evenement evt) {
+  if (evt == RIEN)
+    return 0;
+  ecritVariable(rejeu, (uint64_t)(tour - rejeu->dernierTour) << BITS_EVENEMENT | evt);
+  rejeu->dernierTour = tour;
+  if (ferror(rejeu->fichier)) {
+    perror("Erreur à l'écriture du rejeu");
+    return -1;
+  }
+  return 0;
+}
+
+/**
+ * @brief Implémentation de la fonction ecritInstantane.
+ */
+int8_t ecritInstantane(Rejeu *rejeu, Partie *partie) {
+  Repere *reperes;
+  size_t n = 0;
+  if (prepareInstantane(rejeu, getTailleModele(partie->modele)))
+    return -1;
+  // Ajout du repère à l'index
+  if (rejeu->nbReperes == rejeu->capacite) {
+    reperes = (Repere *)realloc(rejeu->reperes, (2 * rejeu->capacite + 16) * sizeof(Repere));
+    if (!reperes) {
+      perror("Erreur à l'instantané du rejeu : Allocation mémoire échouée");
+      return -1;
+    }
+    rejeu->reperes = reperes, rejeu->capacite = 2 * rejeu->capacite + 16;
+  }
+  ecritVariable(rejeu, (uint64_t)(partie->tour - rejeu->dernierTour) << BITS_EVENEMENT |
+                           CODE_INSTANTANE);
+  rejeu->dernierTour = partie->tour;
+  rejeu->reperes[rejeu->nbReperes++] = (Repere){partie->tour, rejeu->position};
+  // L'état de la partie puis le bloc du modèle compressé
+  n += metVariable(rejeu->tampon + n, partie->nbAppel);
+  n += metVariable(rejeu->tampon + n, partie->delai);
+  n += metVariable(rejeu->tampon + n, partie->estEnPause);
+  n += metVariable(rejeu->tampon + n, partie->estTermine);
+  n += metVariable(rejeu->tampon + n, partie->aCible);
+  n += metVariable(rejeu->tampon + n, partie->cible.rotation);
+  n += metVariable(rejeu->tampon + n, (uint16_t)partie->cible.x0);
+  n += metVariable(rejeu->tampon + n, (uint16_t)partie->cible.y0);
+  n += metModele(rejeu->tampon + n, partie->modele);
+  ecritVariable(rejeu, n);
+  ecritOctets(rejeu, rejeu->tampon, n);
+  if (ferror(rejeu->fichier)) {
+    perror("Erreur à l'écriture du rejeu");
+    return -1;
+  }
+  return 0;
+}
+
+/**
+ * @brief Implémentation de la fonction chercheRejeu.
+ */
+int8_t chercheRejeu(Rejeu *rejeu, Partie *partie, uint32_t tour) {
+  uint32_t debut = 0, fin = rejeu->nbReperes, milieu;
+  Evenement evts[MAX_EVENEMENTS];
+  Repere *repere;
+  uint16_t nb, i;
+  // On cherche le dernier instantané avant le tour
+  while (debut < fin) {
+    milieu = (debut + fin) / 2;
+    if (rejeu->reperes[milieu].tour <= tour)
+      debut = milieu + 1;
+    else
+      fin = milieu;
+  }
+  // On le restaure si la partie est après le tour ou plus loin de lui que l'instantané
+  repere = debut ? &rejeu->reperes[debut - 1] : NULL;
+  if (partie->tour > tour || (repere && repere->tour > partie->tour)) {
+    if (!repere) {
+      fprintf(stderr, "Erreur à la recherche dans le rejeu : Aucun instantané avant le tour %u\n",
+              tour);
+      return -1;
+    }
+    if (placeRejeu(rejeu, repere->position)) {
+      fprintf(stderr, "Erreur à la recherche dans le rejeu : Position de l'instantané invalide\n");
+      return -1;
+    }
+    rejeu->dernierTour = repere->tour;
+    rejeu->estFini = 0;
+    if (lisInstantane(rejeu, partie))
+      return -1;
+    lisProchain(rejeu);
+  }
+  // On simule les tours restants (jusqu'à ECHAP, la fin de la partie enregistrée)
+  while (partie->tour < tour && !estFiniRejeu(rejeu)) {
+    nb = lisEvenements(rejeu, partie->tour, evts, MAX_EVENEMENTS);
+    for (i = 0; i < nb && evts[i] != ECHAP; i++)
+      ;
+    if (i < nb)
+      break;
+    if (joueTour(partie, evts, nb) == -1)
+      return -1;
+  }
+  return 0;
+}
+
+/**
+ * @brief Implémentation de la fonction lisEvenement.
+ */
+Evenement lisEvenement(Rejeu *rejeu, uint32_t tour) {
+  Evenement evt;
+  if (rejeu->estFini || tour != rejeu->tourProchain)
+    return RIEN;
+  evt = rejeu->prochain;
+  rejeu->dernierTour = tour;
+  lisProchain(rejeu);
+  return evt;
+}
+
+/**
+ * @brief Implémentation de la fonction lisEvenements.
+ */
+uint16_t lisEvenements(Rejeu *rejeu, uint32_t tour, Evenement *evts, uint16_t max) {
+  uint16_t n = 0;
+  while (n < max && (evts[n] = lisEvenement(rejeu, tour)) != RIEN)
+    n++;
+  return n;
+}
+
+/**
+ * @brief Implémentation de la fonction estFiniRejeu.
+ */
+uint8_t estFiniRejeu(Rejeu *rejeu) {
+  return rejeu->estFini;
+}
+
+/**
+ * @brief Implémentation de la fonction fermeRejeu.
+ */
+void fermeRejeu(Rejeu *rejeu) {
+  if (!rejeu)
+    return;
+  // Écriture de l'index à la fin du fichier
+  if (rejeu->enEcriture) {
+    for (uint32_t i = 0; i < rejeu->nbReperes; i++) {
+      ecritEntier(rejeu, rejeu->reperes[i].tour, 4);
+      ecritEntier(rejeu, rejeu->reperes[i].position, 8);
+    }
+    ecritEntier(rejeu, rejeu->nbReperes, 4);
+    ecritOctets(rejeu, SIGNATURE_INDEX, 4);
+  }
+  if (rejeu->fichier)
+    fclose(rejeu->fichier);
+  free(rejeu->reperes);
+  free(rejeu->tampon);
+  free(rejeu->instantane);
+  free(rejeu);
+}
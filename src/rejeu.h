@@ -0,0 +1,137 @@
+#ifndef REJEU_H
+#define REJEU_H
+
+#include <stdio.h>
+
+#include "partie.h"
+
+// Macro pour le nombre de formes posées entre deux instantanés d'un enregistrement
+#define POSES_PAR_INSTANTANE 64
+
+// Structure d'un repère de l'index : le tour d'un instantané et sa position dans le fichier
+typedef struct repere {
+  uint32_t tour;
+  uint64_t position;
+} Repere;
+
+// Structure d'un fichier de rejeu : l'en-tête (dimensions, graine et IA) suivi des évènements de
+// la partie, chacun sur un entier variable (le nombre de tours depuis l'évènement précédent décalé
+// de 4 bits puis l'évènement). Des instantanés de la partie (ses valeurs et celles du modèle champ
+// par champ puis le terrain compressé) sont glissés entre les évènements et l'index de leurs
+// positions est écrit à la fin du fichier.
+typedef struct rejeu {
+  // Fichier du rejeu ou octets du rejeu en mémoire (NULL si il est dans un fichier) et sa taille
+  FILE *fichier;
+  const uint8_t *octets;
+  uint64_t taille;
+  uint16_t nbLignes, nbColonnes;
+  uint64_t graine;
+  uint8_t avecIA, enEcriture;
+  // Position dans le fichier et position de la fin des évènements (le début de l'index)
+  uint64_t position, fin;
+  // Tour du dernier évènement écrit ou lu
+  uint32_t dernierTour;
+  // En lecture : le prochain évènement, son tour et 1 si il n'y en a plus
+  Evenement prochain;
+  uint32_t tourProchain;
+  uint8_t estFini;
+  // Index des instantanés
+  Repere *reperes;
+  uint32_t nbReperes, capacite;
+  // Instantané compressé et modèle où il est lu avant d'être vérifié (alloués à la première
+  // utilisation)
+  uint8_t *tampon, *instantane;
+  size_t tailleInstantane;
+} Rejeu;
+
+/**
+ * @brief Crée un fichier de rejeu et écrit son en-tête.
+ * @param chemin représente le chemin du fichier.
+ * @param nbLignes représente le nombre de lignes du terrain du jeu.
+ * @param nbColonnes représente le nombre de colonnes du terrain du jeu.
+ * @param graine représente la graine du générateur des formes.
+ * @param avecIA vaut 1 si c'est l'IA qui joue et 0 si non.
+ * @return le rejeu créé (que l'on doit fermer) ou NULL si il y'a erreur.
+ */
+Rejeu *creeRejeu(const char *chemin, uint16_t nbLignes, uint16_t nbColonnes, uint64_t graine,
+                 uint8_t avecIA);
+
+/**
+ * @brief Ouvre un fichier de rejeu en lecture et lit son en-tête.
+ * @param chemin représente le chemin du fichier.
+ * @return le rejeu ouvert (que l'on doit fermer) ou NULL si il y'a erreur.
+ */
+Rejeu *ouvreRejeu(const char *chemin);
+
+/**
+ * @brief Ouvre un rejeu déjà en mémoire (par exemple un fichier projeté avec mmap) et lit son
+ * en-tête. Les octets sont lus sur place, sans copie, et doivent rester valides jusqu'à sa
+ * fermeture.
+ * @param octets représente les octets du rejeu.
+ * @param taille représente le nombre d'octets.
+ * @return le rejeu ouvert (que l'on doit fermer) ou NULL si il y'a erreur.
+ */
+Rejeu *ouvreRejeuMemoire(const void *octets, size_t taille);
+
+/**
+ * @brief Écrit un évènement à la fin du rejeu. Les évènements RIEN ne sont pas écrits et un tour
+ * peut avoir plusieurs évènements.
+ * @param rejeu représente le rejeu créé. (Paramètre modifié)
+ * @param tour représente le tour de l'évènement (pas avant celui du précédent).
+ * @param evt représente l'évènement.
+ * @return 0 si tous s'est bien passée et -1 si non.
+ */
+int8_t ecritEvenement(Rejeu *rejeu, uint32_t tour, Evenement evt);
+
+/**
+ * @brief Lit l'évènement d'un tour du rejeu. Les tours doivent être lus dans l'ordre.
+ * @param rejeu représente le rejeu ouvert. (Paramètre modifié)
+ * @param tour représente le tour.
+ * @return l'évènement du tour ou RIEN si il n'y en a pas.
+ */
+Evenement lisEvenement(Rejeu *rejeu, uint32_t tour);
+
+/**
+ * @brief Écrit un instantané de la partie à la fin du rejeu (au tour où elle en est) et l'ajoute à
+ * l'index. Le modèle y est copié tel quel (le même bloc que instantaneModele) puis compressé.
+ * @param rejeu représente le rejeu créé. (Paramètre modifié)
+ * @param partie représente la partie enregistrée.
+ * @return 0 si tous s'est bien passée et -1 si non.
+ */
+int8_t ecritInstantane(Rejeu *rejeu, Partie *partie);
+
+/**
+ * @brief Amène la partie rejouée à un tour : on restaure le dernier instantané de l'index avant ce
+ * tour (si la partie n'en est pas déjà plus près) puis on ne simule que les tours restants.
+ * @param rejeu représente le rejeu ouvert. (Paramètre modifié)
+ * @param partie représente la partie rejouée, de mêmes dimensions. (Paramètre modifié)
+ * @param tour représente le tour où aller (on s'arrête avant si le rejeu finit).
+ * @return 0 si tous s'est bien passée et -1 si non.
+ */
+int8_t chercheRejeu(Rejeu *rejeu, Partie *partie, uint32_t tour);
+
+/**
+ * @brief Lit tous les évènements d'un tour du rejeu. Les tours doivent être lus dans l'ordre.
+ * @param rejeu représente le rejeu ouvert. (Paramètre modifié)
+ * @param tour représente le tour.
+ * @param evts représente l'espace où stocker les évènements. (Paramètre modifié)
+ * @param max représente le nombre maximum d'évènements à lire.
+ * @return le nombre d'évènements du tour (0 si il n'y en a pas).
+ */
+uint16_t lisEvenements(Rejeu *rejeu, uint32_t tour, Evenement *evts, uint16_t max);
+
+/**
+ * @brief Vérifie si tous les évènements du rejeu ont été lus.
+ * @param rejeu représente le rejeu ouvert.
+ * @return 1 si il est fini et 0 si non.
+ */
+uint8_t estFiniRejeu(Rejeu *rejeu);
+
+/**
+ * @brief Ferme le fichier du rejeu (après avoir écrit son index si il est en écriture) et libère
+ * le rejeu.
+ * @param rejeu représente le rejeu à fermer.
+ */
+void fermeRejeu(Rejeu *rejeu);
+
+#endif
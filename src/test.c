@@ -0,0 +1,74 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "modele.h"
+
+// Identifiant de la forme I dans la table LES_FORMES (debout dans sa rotation 0)
+#define FORME_I 6
+
+/**
+ * @brief Vérifie qu'un dépôt de 4 lignes à un grand coefficient, qui fait passer plusieurs niveaux
+ * d'un coup, arrête le délai au minimum au lieu de le faire passer sous zéro : l'état reste valide
+ * et peut être rechargé d'un instantané.
+ * @return 0 si la vérification est passée et 1 si non.
+ */
+static uint8_t verifieDelaiQuatreLignes(void) {
+  Modele *modele = initModele(20, 10, 1);
+  Depot depot;
+  uint16_t y, bas;
+  uint8_t err = 0;
+  if (!modele)
+    return 1;
+  // Les 4 lignes du bas sont pleines sauf la colonne 0, où la forme I debout va tomber
+  bas = modele->nbLignes - NB_CASES_FORME;
+  for (y = bas; y < modele->nbLignes; y++) {
+    modele->lignes[y] = modele->lignePleine & ~1ULL;
+    for (uint16_t x = 1; x < modele->nbColonnes; x++)
+      modele->terrain[y * modele->nbColonnes + x] = ROUGE;
+  }
+  modele->forme = (Forme){FORME_I, 0, 0, 0, CYAN};
+  // Le score passe de 115 à 163 : le coefficient saute de 12 à 17, soit 5 niveaux
+  modele->score = 115, modele->coef = 12, modele->delai = 60;
+  if (reconstruitModele(modele)) {
+    fprintf(stderr, "Échec : l'état de départ est refusé\n");
+    detruitModele(modele);
+    return 1;
+  }
+
+  joueDepot(modele, 0, 0, bas, &depot);
+  if (getLignesSupprimees(modele) != 0xFULL << bas || getScore(modele) != 163 ||
+      modele->coef != 17) {
+    fprintf(stderr, "Échec : les 4 lignes n'ont pas été supprimées (score %u, coefficient %u)\n",
+            getScore(modele), modele->coef);
+    err = 1;
+  } else if (getDelai(modele) > depot.delai) {
+    fprintf(stderr, "Échec : le délai est passé de %u à %u\n", depot.delai, getDelai(modele));
+    err = 1;
+  } else if (reconstruitModele(modele)) {
+    fprintf(stderr, "Échec : l'état après le dépôt (délai %u) est refusé\n", getDelai(modele));
+    err = 1;
+  }
+  detruitModele(modele);
+  return err;
+}
+
+// Table des vérifications lancées par le programme
+static const struct {
+  const char *nom;
+  uint8_t (*verifie)(void);
+} VERIFICATIONS[] = {{"délai après 4 lignes à un grand coefficient", verifieDelaiQuatreLignes}};
+
+/**
+ * @brief Lance les vérifications du moteur et affiche celles qui échouent.
+ * @return EXIT_SUCCESS si toutes sont passées et EXIT_FAILURE si non.
+ */
+int main(void) {
+  uint32_t nb = sizeof(VERIFICATIONS) / sizeof(VERIFICATIONS[0]), echecs = 0;
+  for (uint32_t i = 0; i < nb; i++)
+    if (VERIFICATIONS[i].verifie()) {
+      fprintf(stderr, "Vérification échouée : %s\n", VERIFICATIONS[i].nom);
+      echecs++;
+    }
+  printf("Vérifications : %u sur %u passées\n", nb - echecs, nb);
+  return echecs ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,18 @@
+#ifndef TETRIS_H
+#define TETRIS_H
+
+// En-tête public de la bibliothèque libtetris : le moteur du jeu sans SDL ni Ncurses. Il donne ce
+// dont ont besoin les lanceurs de parties et les IA : le modèle (requêtes, dépôt et annulation,
+// instantanés), les placements, l'IA, les politiques, la partie et les rejeux. La table des
+// rotations (forme.h) et la cadence des tours (tour.h) restent internes au moteur
+#include "alea.h"
+#include "arene.h"
+#include "evenement.h"
+#include "ia.h"
+#include "modele.h"
+#include "partie.h"
+#include "placement.h"
+#include "politique.h"
+#include "rejeu.h"
+
+#endif
@@ -0,0 +1,12 @@
+#ifndef TOUR_H
+#define TOUR_H
+
+// En-tête interne à la partie et au contrôleur : la cadence des tours ne fait pas partie de
+// l'en-tête public tetris.h
+
+// Macro pour la valeur d'incrémentation du delai
+#define INC_DELAI 75
+// Macro pour le nombre de tours avant l'avancement de la forme
+#define MAX_APPEL 5
+
+#endif
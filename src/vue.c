@@ -1,9 +1,308 @@
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#include <unistd.h>
 
 #include "vue.h"
 #include "vueNcurses.h"
 #include "vueSDL.h"
 
+// Macro pour le bit de l'indice du milieu du triple tampon qui indique une image pas encore prise
+#define NOUVELLE 4
+// Macro pour le masque de l'indice d'une image du triple tampon
+#define INDICE 3
+
+// Structure de l'affichage : le thread qui dessine et le triple tampon des images. Le jeu écrit
+// dans images[ecriture], le thread dessine images[lecture] et ils échangent leur image avec celle
+// du milieu d'un seul échange atomique, sans verrou
+struct affichage {
+  pthread_t thread;
+  ImageVue images[3];
+  uint8_t ecriture, lecture;
+  _Atomic uint8_t milieu;
+  // Tube pour réveiller le thread et tube des évènements qu'il lit pour le jeu (quand la vue a une
+  // entrée)
+  int reveil[2], entrees[2];
+  // Fonction d'écoute de la vue, appelée par le thread
+  uint16_t (*ecoute)(Vue *, EvenementDate *, uint16_t);
+  // Sémaphore et résultat du début du dessin dans le thread, puis demande d'arrêt
+  sem_t pret;
+  uint8_t erreur;
+  _Atomic uint8_t aArreter;
+  // Évènements du joueur déjà affichés (nombre et somme des dates) et latence mesurée
+  _Atomic uint64_t nbVus;
+  int64_t sommeVue;
+  Latences latences;
+};
+
+/**
+ * @brief Attend qu'un descripteur soit prêt à être lu sans consommer de processeur.
+ * @param fd représente le descripteur.
+ * @param echeance représente l'heure (getDate) jusqu'à laquelle attendre, négative si il n'y a pas
+ * de limite.
+ */
+static void attendsDescripteur(int fd, int64_t echeance) {
+  struct pollfd entree = {fd, POLLIN, 0};
+  int64_t reste = echeance - getDate();
+  // poll compte en millisecondes, on arrondit au-dessus pour ne pas se réveiller avant l'heure
+  if (echeance < 0)
+    poll(&entree, 1, -1);
+  else if (reste > 0)
+    poll(&entree, 1, (int)((reste + 999999) / 1000000));
+}
+
+/**
+ * @brief Réveille le thread d'affichage, par la vue si elle attend elle-même son entrée et par le
+ * tube de réveil si non. Si le tube est plein, le thread est déjà réveillé.
+ * @param vue représente la vue.
+ */
+static void reveille(Vue *vue) {
+  ssize_t ret;
+  if (vue->reveilleEntree) {
+    vue->reveilleEntree(vue);
+    return;
+  }
+  ret = write(vue->affichage->reveil[1], "", 1);
+  (void)ret;
+}
+
+/**
+ * @brief Écoute les évènements que le thread d'affichage a lus pour le jeu.
+ * @param vue représente la vue.
+ * @param evts représente l'espace où stocker les évènements. (Paramètre modifié)
+ * @param max représente le nombre maximum d'évènements à lire.
+ * @return le nombre d'évènements lus.
+ */
+static uint16_t ecouteAffichage(Vue *vue, EvenementDate *evts, uint16_t max) {
+  // Les évènements sont écrits entiers dans le tube, on les lit donc entiers
+  ssize_t n = read(vue->affichage->entrees[0], evts, max * sizeof(EvenementDate));
+  return n > 0 ? n / sizeof(EvenementDate) : 0;
+}
+
+/**
+ * @brief Attend un évènement lu par le thread d'affichage.
+ * @param vue représente la vue.
+ * @param echeance représente l'heure (getDate) jusqu'à laquelle attendre, négative si il n'y a pas
+ * de limite.
+ */
+static void attendsAffichage(Vue *vue, int64_t echeance) {
+  attendsDescripteur(vue->affichage->entrees[0], echeance);
+}
+
+/**
+ * @brief Prend l'image du milieu du triple tampon si le jeu en a publié une nouvelle.
+ * @param a représente l'affichage. (Paramètre modifié)
+ * @return 1 si une nouvelle image est dans images[lecture] et 0 si non.
+ */
+static uint8_t prendImage(Affichage *a) {
+  if (!(atomic_load_explicit(&a->milieu, memory_order_relaxed) & NOUVELLE))
+    return 0;
+  a->lecture = atomic_exchange_explicit(&a->milieu, a->lecture, memory_order_acq_rel) & INDICE;
+  return 1;
+}
+
+/**
+ * @brief Dessine l'image prise puis compte la latence des évènements du joueur qu'elle montre : le
+ * temps entre leur date et la fin du dessin.
+ * @param vue représente la vue.
+ */
+static void dessineImage(Vue *vue) {
+  Affichage *a = vue->affichage;
+  const ImageVue *image = &a->images[a->lecture];
+  uint64_t nb = image->entrees.nb - atomic_load_explicit(&a->nbVus, memory_order_relaxed);
+  int64_t present;
+  if (vue->dessine(vue, image) || !nb)
+    return;
+  present = getDate();
+  a->latences.nb += nb;
+  a->latences.somme += nb * present - (image->entrees.sommeDates - a->sommeVue);
+  if (present - image->entrees.plusAncienne > a->latences.max)
+    a->latences.max = present - image->entrees.plusAncienne;
+  a->sommeVue = image->entrees.sommeDates;
+  atomic_store_explicit(&a->nbVus, image->entrees.nb, memory_order_release);
+}
+
+/**
+ * @brief Fonction du thread d'affichage : il dort jusqu'à ce que le jeu publie une image (ou que
+ * l'entrée soit prête) et dessine toujours la plus récente. Le jeu n'attend donc jamais le dessin.
+ * @param arg représente la vue.
+ * @return NULL.
+ */
+static void *afficheImages(void *arg) {
+  Vue *vue = (Vue *)arg;
+  Affichage *a = vue->affichage;
+  EvenementDate evts[MAX_EVENEMENTS];
+  struct pollfd fds[2] = {{a->reveil[0], POLLIN, 0}, {vue->entree, POLLIN, 0}};
+  char vide[64];
+  uint16_t nb;
+
+  // On prépare le dessin dans le thread (certaines vues ne dessinent que depuis leur thread)
+  a->erreur = vue->debutDessin && vue->debutDessin(vue);
+  sem_post(&a->pret);
+  if (a->erreur)
+    return NULL;
+
+  while (!atomic_load(&a->aArreter)) {
+    // Une vue sans descripteur (SDL) attend elle-même son entrée, qui ne peut être lue que depuis
+    // ce thread
+    if (vue->attendsEntree) {
+      vue->attendsEntree(vue);
+      fds[0].revents = 0, fds[1].revents = POLLIN;
+    } else
+      poll(fds, vue->entree >= 0 ? 2 : 1, -1);
+    // On transmet au jeu les évènements de l'entrée, on ne l'écoute plus si elle est fermée
+    if (fds[1].revents & POLLIN) {
+      if ((nb = a->ecoute(vue, evts, MAX_EVENEMENTS)) &&
+          write(a->entrees[1], evts, nb * sizeof(EvenementDate)) < 0)
+        perror("Erreur à la lecture des évènements : Tube plein");
+    } else if (fds[1].revents & (POLLHUP | POLLERR))
+      fds[1].fd = -1;
+    // On vide le tube de réveil puis on dessine la dernière image si elle est nouvelle
+    if (fds[0].revents & POLLIN)
+      while (read(a->reveil[0], vide, sizeof(vide)) > 0)
+        ;
+    if (prendImage(a))
+      dessineImage(vue);
+  }
+  // On dessine la dernière image publiée avant l'arrêt
+  if (prendImage(a))
+    dessineImage(vue);
+  if (vue->finDessin)
+    vue->finDessin(vue);
+  return NULL;
+}
+
+/**
+ * @brief Crée un tube dont les deux bouts ne bloquent pas.
+ * @param tube représente les deux bouts du tube. (Paramètre modifié)
+ * @return 0 si tous s'est bien passée et -1 si non.
+ */
+static int8_t creeTube(int tube[2]) {
+  if (pipe(tube))
+    return -1;
+  fcntl(tube[0], F_SETFL, O_NONBLOCK);
+  fcntl(tube[1], F_SETFL, O_NONBLOCK);
+  return 0;
+}
+
+/**
+ * @brief Ferme les tubes de l'affichage et le libère.
+ * @param a représente l'affichage à détruire.
+ */
+static void detruitAffichage(Affichage *a) {
+  for (int i = 0; i < 2; i++) {
+    if (a->reveil[i] >= 0)
+      close(a->reveil[i]);
+    if (a->entrees[i] >= 0)
+      close(a->entrees[i]);
+  }
+  sem_destroy(&a->pret);
+  free(a);
+}
+
+/**
+ * @brief Crée l'affichage de la vue et lance son thread. Si la vue a une entrée, le jeu écoute
+ * ensuite les évènements que le thread lui transmet.
+ * @param vue représente la vue. (Paramètre modifié)
+ * @return 0 si tous s'est bien passée et -1 si non.
+ */
+static int8_t lanceAffichage(Vue *vue) {
+  uint8_t aEntree = vue->entree >= 0 || vue->attendsEntree;
+  Affichage *a = (Affichage *)calloc(1, sizeof(Affichage));
+  if (!a) {
+    perror("Erreur à la création de l'affichage : Allocation mémoire échouée");
+    return -1;
+  }
+  a->reveil[0] = a->reveil[1] = a->entrees[0] = a->entrees[1] = -1;
+  // Les images 0 et 1 sont au jeu et au thread, la 2 est au milieu
+  a->ecriture = 0, a->lecture = 1;
+  atomic_init(&a->milieu, 2);
+  sem_init(&a->pret, 0, 0);
+  if (creeTube(a->reveil) || (aEntree && creeTube(a->entrees))) {
+    perror("Erreur à la création de l'affichage : Création des tubes échouée");
+    detruitAffichage(a);
+    return -1;
+  }
+  vue->affichage = a;
+  if (aEntree) {
+    a->ecoute = vue->ecoute;
+    vue->ecoute = ecouteAffichage, vue->attends = attendsAffichage;
+  }
+
+  // On lance le thread et on attend qu'il ait préparé le dessin
+  if (pthread_create(&a->thread, NULL, afficheImages, vue)) {
+    fprintf(stderr, "Erreur à la création de l'affichage : Création du thread échouée\n");
+    a->erreur = 1;
+  } else {
+    sem_wait(&a->pret);
+    if (a->erreur)
+      pthread_join(a->thread, NULL);
+  }
+  if (a->erreur) {
+    vue->affichage = NULL;
+    detruitAffichage(a);
+    return -1;
+  }
+  return 0;
+}
+
+/**
+ * @brief Écoute les évènements de la vue sans affichage : il n'y en a jamais.
+ * @return 0.
+ */
+static uint16_t ecouteAucune(Vue *vue, EvenementDate *evts, uint16_t max) {
+  return 0;
+}
+
+/**
+ * @brief Attend sans affichage : aucun évènement ne peut arriver, on dort jusqu'à l'heure donnée.
+ * @param vue représente la vue.
+ * @param echeance représente l'heure (getDate) jusqu'à laquelle attendre, négative si il n'y a pas
+ * de limite (on n'attend alors pas).
+ */
+static void attendsAucune(Vue *vue, int64_t echeance) {
+  struct timespec reveil;
+  if (echeance < 0)
+    return;
+  reveil.tv_sec = echeance / 1000000000LL, reveil.tv_nsec = echeance % 1000000000LL;
+  clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &reveil, NULL);
+}
+
+/**
+ * @brief Détruit la vue sans affichage.
+ * @param vue représente la vue à détruire.
+ */
+static void detruitAucune(Vue *vue) {
+  free(vue);
+}
+
+/**
+ * @brief Crée la vue sans affichage (elle n'a pas de thread d'affichage).
+ * @param nbLignes représente le nombre de lignes du terrain du jeu.
+ * @param nbColonnes représente le nombre de colonnes du terrain du jeu.
+ * @return un pointeur vers la vue ou NULL si il y'a eu erreur
+ */
+static Vue *initVueAucune(uint16_t nbLignes, uint16_t nbColonnes) {
+  Vue *vue = (Vue *)calloc(1, sizeof(Vue));
+  if (!vue) {
+    perror("Erreur à la création de la vue : Allocation mémoire échouée");
+    return NULL;
+  }
+  vue->nbLignes = nbLignes;
+  vue->nbColonnes = nbColonnes;
+  vue->ecoute = ecouteAucune;
+  vue->attends = attendsAucune;
+  vue->entree = -1;
+  vue->detruitVue = detruitAucune;
+  return vue;
+}
+
 /**
  * @brief Implémentation de la fonction initVue.
  */
@@ -13,6 +312,65 @@ Vue *initVue(char *vtype, uint16_t nbLignes, uint16_t nbColonnes) {
     ret = initVueNcurses(nbLignes, nbColonnes);
   } else if (!strcmp(vtype, "sdl")) {
     ret = initVueSDL(nbLignes, nbColonnes);
+  } else if (!strcmp(vtype, "aucune")) {
+    ret = initVueAucune(nbLignes, nbColonnes);
+  }
+  // On lance le thread d'affichage si la vue dessine
+  if (ret && ret->dessine && lanceAffichage(ret)) {
+    ret->detruitVue(ret);
+    ret = NULL;
   }
   return ret;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Implémentation de la fonction publieImage.
+ */
+void publieImage(Vue *vue, Modele *modele, int8_t errEtColl, uint16_t pause, uint16_t fini,
+                 const Entrees *entrees) {
+  Affichage *a = vue->affichage;
+  ImageVue *image;
+  if (!a)
+    return;
+  image = &a->images[a->ecriture];
+  getImage(modele, &image->modele);
+  image->errEtColl = errEtColl, image->pause = pause, image->fini = fini;
+  image->entrees = *entrees;
+  // On échange l'image avec celle du milieu puis on réveille le thread
+  a->ecriture =
+      atomic_exchange_explicit(&a->milieu, a->ecriture | NOUVELLE, memory_order_acq_rel) & INDICE;
+  reveille(vue);
+}
+
+/**
+ * @brief Implémentation de la fonction getNbEntreesAffichees.
+ */
+uint64_t getNbEntreesAffichees(Vue *vue) {
+  return vue->affichage ? atomic_load_explicit(&vue->affichage->nbVus, memory_order_acquire) : 0;
+}
+
+/**
+ * @brief Implémentation de la fonction fermeVue.
+ */
+void fermeVue(Vue *vue, Latences *latences) {
+  Affichage *a = vue->affichage;
+  *latences = (Latences){0};
+  if (a) {
+    atomic_store(&a->aArreter, 1);
+    reveille(vue);
+    pthread_join(a->thread, NULL);
+    *latences = a->latences;
+    detruitAffichage(a);
+    vue->affichage = NULL;
+  }
+  vue->detruitVue(vue);
+}
+
+/**
+ * @brief Implémentation de la fonction getDate.
+ */
+int64_t getDate(void) {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec * 1000000000LL + t.tv_nsec;
+}
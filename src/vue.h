@@ -2,43 +2,114 @@
 #define VUE_H
 
 #include "modele.h"
+#include "partie.h"
 
 // Macros pour les differents messages dans le jeu
-#define MSG_JEU \
-  "FLECHE pour diriger\n\nESPACE pour tourner\n\nENTREE pour pauser\n\nECHAP  pour sortir"
+#define MSG_JEU                                                                                 \
+  "FLECHE pour diriger\n\nESPACE pour tourner\n\nC pour faire chuter\n\nENTREE pour pauser\n\n" \
+  "ECHAP  pour sortir"
 
 #define MSG_PAUSE "ENTREE pour jouer\n\nR pour recommencer\n\nECHAP pour quitter"
 #define MSG_FIN "ECHAP pour quitter le jeu\n\nR pour recommencer le jeu"
 
-// Énumération des évènements interprétés
-typedef enum evenement {
-  ECHAP = 0,
-  ESPACE,
-  ENTREE,
-  FGAUCHE,
-  FHAUT,
-  FDROITE,
-  FBAS,
-  TOUCHE_R,
-  RIEN
-} Evenement;
-
-// Structure de la vue du jeu
+// Structure d'un évènement daté : l'évènement et l'heure (getDate) où l'utilisateur l'a lancé
+typedef struct evenementDate {
+  Evenement evt;
+  int64_t date;
+} EvenementDate;
+
+// Structure des évènements du joueur depuis le début : leur nombre, la somme de leurs dates et la
+// date du plus ancien qui n'a pas encore été affiché
+typedef struct entrees {
+  uint64_t nb;
+  int64_t sommeDates, plusAncienne;
+} Entrees;
+
+// Structure de la latence entre les évènements du joueur et leur affichage (en nanosecondes)
+typedef struct latences {
+  uint64_t nb;
+  int64_t somme, max;
+} Latences;
+
+// Structure d'une image publiée par le jeu pour l'affichage : l'image du modèle, l'état de la
+// partie et les évènements du joueur qu'elle montre
+typedef struct imageVue {
+  Image modele;
+  int8_t errEtColl;
+  uint16_t pause, fini;
+  Entrees entrees;
+} ImageVue;
+
+// Structure de l'affichage dans son thread (propre à vue.c)
+typedef struct affichage Affichage;
+
+// Structure de la vue du jeu. Le jeu appelle ecoute, qui lit tous les évènements en attente (sans
+// RIEN) et renvoie leur nombre, et attends, qui bloque jusqu'à un évènement ou jusqu'à l'heure
+// donnée (getDate, sans limite si elle est négative). Le thread d'affichage appelle debutDessin
+// une fois, dessine pour chaque image puis finDessin (NULL si il n'y a rien à faire, dessine est
+// NULL si il n'y a pas d'affichage). Si entree est un descripteur (et non -1), c'est aussi le thread
+// d'affichage qui appelle ecoute quand il est prêt et qui transmet les évènements au jeu
 typedef struct vue {
   void *data;
   uint16_t nbLignes, nbColonnes;
-  Evenement (*ecoute)();
-  uint8_t (*metVueAJour)(struct vue *, Modele *, int8_t, uint16_t, uint16_t);
+  uint16_t (*ecoute)(struct vue *, EvenementDate *, uint16_t);
+  void (*attends)(struct vue *, int64_t);
+  uint8_t (*debutDessin)(struct vue *);
+  uint8_t (*dessine)(struct vue *, const ImageVue *);
+  void (*finDessin)(struct vue *);
+  int entree;
+  // Pour une vue dont l'entrée n'est pas un descripteur : attente d'un évènement ou d'un réveil
+  // dans le thread d'affichage, et réveil de cette attente depuis le jeu
+  void (*attendsEntree)(struct vue *);
+  void (*reveilleEntree)(struct vue *);
   void (*detruitVue)(struct vue *);
+  Affichage *affichage;
 } Vue;
 
 /**
- * @brief Crée et initialise la vue SDL ou Ncurses selon ce que l'utilisateur a choisi.
- * @param vtype représente le choix de l'utilisateur. Sa valeur est soit "sdl", soit "ncurses".
+ * @brief Crée et initialise la vue SDL, Ncurses ou aucune vue selon ce que l'utilisateur a choisi.
+ * @param vtype représente le choix de l'utilisateur. Sa valeur est soit "sdl", soit "ncurses", soit
+ * "aucune" (rien n'est affiché et aucun évènement n'est lu, pour rejouer une partie au plus vite).
  * @param nbLignes représente le nombre de lignes du terrain du jeu.
  * @param nbColonnes représente le nombre de colonnes du terrain du jeu.
  * @return un pointeur vers la vue ou NULL si il y'a eu erreur
  */
 Vue *initVue(char *vtype, uint16_t nbLignes, uint16_t nbColonnes);
 
+/**
+ * @brief Publie l'image du jeu après un tour sans attendre qu'elle soit affichée : elle passe par un
+ * triple tampon sans verrou et le thread d'affichage dessine toujours la plus récente (les images
+ * publiées entre deux dessins sont sautées).
+ * @param vue représente la vue. (Paramètre modifié)
+ * @param modele représente le modèle du jeu.
+ * @param errEtColl vaut 1 si la forme est tombée, 0 si tous s'est bien passée et -1 si non.
+ * @param pause vaut 1 si la partie est en pause.
+ * @param fini vaut 1 si la partie est finie.
+ * @param entrees représente les évènements du joueur jusqu'à ce tour.
+ */
+void publieImage(Vue *vue, Modele *modele, int8_t errEtColl, uint16_t pause, uint16_t fini,
+                 const Entrees *entrees);
+
+/**
+ * @brief Permet d'avoir le nombre d'évènements du joueur déjà affichés (d'après les images
+ * dessinées, il peut être en retard sur le thread d'affichage).
+ * @param vue représente la vue.
+ * @return le nombre d'évènements affichés.
+ */
+uint64_t getNbEntreesAffichees(Vue *vue);
+
+/**
+ * @brief Arrête le thread d'affichage après qu'il a dessiné la dernière image, donne la latence des
+ * évènements du joueur puis détruit la vue.
+ * @param vue représente la vue à fermer.
+ * @param latences représente la latence mesurée à l'affichage. (Paramètre modifié)
+ */
+void fermeVue(Vue *vue, Latences *latences);
+
+/**
+ * @brief Permet d'avoir l'heure de l'horloge monotone, celle des évènements datés.
+ * @return l'heure en nanosecondes.
+ */
+int64_t getDate(void);
+
 #endif
\ No newline at end of file
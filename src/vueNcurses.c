@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <unistd.h>
 
 #include "vueNcurses.h"
 
@@ -25,20 +26,43 @@ WINDOW *creeBox(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
   return win;
 }
 
+/**
+ * @brief Dessine une case bordée de HAUT_CASE lignes et LARG_CASE colonnes dans la fenêtre, avec
+ * la couleur spécifiée comme couleur de fond.
+ * @param win représente la fenêtre des cases.
+ * @param x représente le numéro de colonne de la case.
+ * @param y représente le numéro de ligne de la case.
+ * @param couleur représente la couleur utilisée pour dessiner la case.
+ */
+static void dessineCaseFenetre(WINDOW *win, uint16_t x, uint16_t y, Couleur couleur) {
+  chtype c = COLOR_PAIR(couleur);
+  int i;
+  // Haut de la case
+  mvwaddch(win, y * HAUT_CASE, x * LARG_CASE, ACS_ULCORNER | c);
+  for (i = 1; i < LARG_CASE - 1; i++)
+    waddch(win, ACS_HLINE | c);
+  waddch(win, ACS_URCORNER | c);
+  // Bas de la case
+  mvwaddch(win, y * HAUT_CASE + HAUT_CASE - 1, x * LARG_CASE, ACS_LLCORNER | c);
+  for (i = 1; i < LARG_CASE - 1; i++)
+    waddch(win, ACS_HLINE | c);
+  // Au coin bas droit de la fenêtre waddch renvoie ERR (le curseur ne peut avancer) mais le
+  // caractère est bien posé
+  waddch(win, ACS_LRCORNER | c);
+}
+
 /**
  * @brief Implémentation de la fonction creeLesCases.
  */
-WINDOW **creeLesCases(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
-  WINDOW **wins = (WINDOW **)malloc(h * w * sizeof(WINDOW *));
+WINDOW *creeLesCases(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+  WINDOW *win = newwin(h * HAUT_CASE, w * LARG_CASE, y, x);
   int i, j;
-  for (i = 0; i < h; i++) {
-    for (j = 0; j < w; j++) {
-      wins[i * w + j] = subwin(stdscr, HAUT_CASE, LARG_CASE, y + i * HAUT_CASE, x + j * LARG_CASE);
-      box(wins[i * w + j], 0, 0);
-      wbkgd(wins[i * w + j], COLOR_PAIR(NOIR));
-    }
-  }
-  return wins;
+  if (!win)
+    return NULL;
+  for (i = 0; i < h; i++)
+    for (j = 0; j < w; j++)
+      dessineCaseFenetre(win, j, i, NOIR);
+  return win;
 }
 
 /**
@@ -47,7 +71,7 @@ WINDOW **creeLesCases(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
 Vue *initVueNcurses(uint16_t nbLignes, uint16_t nbColonnes) {
   uint16_t x, y, w, h;
   // Création de la vue Ncurses
-  Vue *vue = (Vue *)malloc(sizeof(Vue));
+  Vue *vue = (Vue *)calloc(1, sizeof(Vue));
   if (!vue) {
     perror("Erreur à la création de la vue Ncurses : Allocation mémoire échouée");
     return NULL;
@@ -56,7 +80,7 @@ Vue *initVueNcurses(uint16_t nbLignes, uint16_t nbColonnes) {
   vue->nbColonnes = nbColonnes;
 
   // Création des données de la vue Ncurses
-  VueNcurses *data = (VueNcurses *)malloc(sizeof(VueNcurses));
+  VueNcurses *data = (VueNcurses *)calloc(1, sizeof(VueNcurses));
   if (!data) {
     perror("Erreur à la création de la vue Ncurses : Allocation mémoire échouée");
     free(vue);
@@ -88,6 +112,7 @@ Vue *initVueNcurses(uint16_t nbLignes, uint16_t nbColonnes) {
   init_pair(BLEU, COLOR_WHITE, COLOR_BLUE);
   init_pair(MAGENTA, COLOR_WHITE, COLOR_MAGENTA);
   init_pair(CYAN, COLOR_WHITE, COLOR_CYAN);
+  init_pair(GRIS, COLOR_YELLOW, COLOR_BLACK);
 
   // Création de la box du jeu
   w = nbColonnes * LARG_CASE + 3 * MARGE_COL + DIM * LARG_CASE;
@@ -101,6 +126,13 @@ Vue *initVueNcurses(uint16_t nbLignes, uint16_t nbColonnes) {
   y = y + MARGE_LIG;
   data->boxTerrain = creeBox(x, y, nbColonnes * LARG_CASE, nbLignes * HAUT_CASE);
   data->terrain = creeLesCases(x, y, nbColonnes, nbLignes);
+  if (!data->terrain) {
+    fprintf(stderr, "Erreur à la création de la fenêtre du terrain Ncurses\n");
+    free(vue);
+    free(data);
+    endwin();
+    return NULL;
+  }
   // Affichage du label du jeu
   mvprintw(y, x - 1 + nbColonnes * LARG_CASE + (2 * MARGE_COL + DIM * LARG_CASE - 12) / 2,
            "T E T R I S");
@@ -112,6 +144,14 @@ Vue *initVueNcurses(uint16_t nbLignes, uint16_t nbColonnes) {
   y = (LINES - h) / 2;
   data->boxSuivante = creeBox(x, y, w, h);
   data->suivante = creeLesCases(x, y, DIM, DIM);
+  if (!data->suivante) {
+    fprintf(stderr, "Erreur à la création de la fenêtre de la forme suivante Ncurses\n");
+    delwin(data->terrain);
+    free(vue);
+    free(data);
+    endwin();
+    return NULL;
+  }
   // Affichage du label de la forme suivante
   mvprintw(y - 2, x - 1 + (w - 16) / 2, "S U I V A N T E");
 
@@ -127,8 +167,9 @@ Vue *initVueNcurses(uint16_t nbLignes, uint16_t nbColonnes) {
   refresh();
 
   // Initialisation du reste des variables
-  vue->metVueAJour = metVueAJourNcurses;
+  vue->dessine = dessineNcurses;
   vue->ecoute = ecouteNcurses;
+  vue->entree = STDIN_FILENO;
   vue->detruitVue = detruitVueNcurses;
   return vue;
 }
@@ -140,7 +181,6 @@ void detruitVueNcurses(Vue *vue) {
   if (!vue)
     return;
   VueNcurses *data = (VueNcurses *)vue->data;
-  int i, j;
   // Destruction de la box du jeu
   delwin(data->boxJeu);
   // Destruction de la box du terrain
@@ -151,19 +191,12 @@ void detruitVueNcurses(Vue *vue) {
   delwin(data->boxScore);
   // Destruction de la box des messages
   delwin(data->boxMessage);
-  // Destruction de toutes les cases du terrain du jeu
-  for (i = 0; i < vue->nbLignes; i++)
-    for (j = 0; j < vue->nbColonnes; j++)
-      delwin(data->terrain[i * vue->nbColonnes + j]);
-  // Destruction de toutes les cases du terrain de la forme suivante
-  for (i = 0; i < DIM; i++)
-    for (j = 0; j < DIM; j++)
-      delwin(data->suivante[i * DIM + j]);
+  // Destruction des cases du terrain du jeu et du terrain de la forme suivante
+  delwin(data->terrain);
+  delwin(data->suivante);
   // Clôture de Ncurses
   endwin();
   // Libération des mémoires
-  free(data->terrain);
-  free(data->suivante);
   free(data);
   free(vue);
 }
@@ -172,22 +205,20 @@ void detruitVueNcurses(Vue *vue) {
  * @brief Implémentation de la fonction dessineCaseNcurses.
  */
 void dessineCaseNcurses(Vue *vue, uint16_t x, uint16_t y, Couleur couleur) {
-  VueNcurses *data = (VueNcurses *)vue->data;
-  wbkgd(data->terrain[y * vue->nbColonnes + x], COLOR_PAIR(couleur));
+  dessineCaseFenetre(((VueNcurses *)vue->data)->terrain, x, y, couleur);
 }
 
 /**
  * @brief Implémentation de la fonction dessineCaseSuivanteNcurses.
  */
 void dessineCaseSuivanteNcurses(Vue *vue, uint16_t x, uint16_t y, Couleur couleur) {
-  VueNcurses *data = (VueNcurses *)vue->data;
-  wbkgd(data->suivante[y * DIM + x], COLOR_PAIR(couleur));
+  dessineCaseFenetre(((VueNcurses *)vue->data)->suivante, x, y, couleur);
 }
 
 /**
  * @brief Implémentation de la fonction dessineFormeNcurses.
  */
-void dessineFormeNcurses(Vue *vue, Couple *coords, Couleur couleur) {
+void dessineFormeNcurses(Vue *vue, const Couple *coords, Couleur couleur) {
   // On parcours les coordonées
   for (int i = 0; i < NB_CASES_FORME; i++)
     // On vérifie si la forme ne deborde pas sur la base
@@ -198,7 +229,7 @@ void dessineFormeNcurses(Vue *vue, Couple *coords, Couleur couleur) {
 /**
  * @brief Implémentation de la fonction dessineFormeSuivanteNcurses.
  */
-void dessineFormeSuivanteNcurses(Vue *vue, Couple *coords, Couleur couleur) {
+void dessineFormeSuivanteNcurses(Vue *vue, const Couple *coords, Couleur couleur) {
   // Nettoie le terrain de la forme suivante
   nettoieTerrainSuivanteNcurses(vue);
   // On parcours les coordonées et on dessine
@@ -209,7 +240,7 @@ void dessineFormeSuivanteNcurses(Vue *vue, Couple *coords, Couleur couleur) {
 /**
  * @brief Implémentation de la fonction dessineTerrainNcurses.
  */
-void dessineTerrainNcurses(Vue *vue, Couleur *terrain) {
+void dessineTerrainNcurses(Vue *vue, const uint8_t *terrain) {
   int i, j;
   // On parcours et on dessine
   for (i = 0; i < vue->nbLignes; i++)
@@ -231,9 +262,9 @@ void nettoieTerrainSuivanteNcurses(Vue *vue) {
 /**
  * @brief Implémentation de la fonction afficherScoreNcurses.
  */
-void afficheScoreNcurses(Vue *vue, uint16_t score) {
+void afficheScoreNcurses(Vue *vue, uint32_t score) {
   VueNcurses *data = (VueNcurses *)vue->data;
-  mvwprintw(data->boxScore, 1, (DIM * LARG_CASE - 18) / 2, "S C O R E : %hu", score);
+  mvwprintw(data->boxScore, 1, (DIM * LARG_CASE - 18) / 2, "S C O R E : %u", score);
 }
 
 /**
@@ -243,14 +274,14 @@ void afficheMessageNcurses(Vue *vue, char *s) {
   VueNcurses *data = (VueNcurses *)vue->data;
   werase(data->boxMessage);
   mvwprintw(data->boxMessage, 1, 0, "%s", s);
-  flushinp();
 }
 
 /**
- * @brief Implémentation de la fonction ecouteNcurses.
+ * @brief Convertit une touche Ncurses en évènement.
+ * @param c représente la touche lue par getch.
+ * @return l'évènement correspondant à la touche.
  */
-Evenement ecouteNcurses() {
-  int c = getch();
+static Evenement convertitToucheNcurses(int c) {
   switch (c) {
     case KEY_UP :
       return FHAUT;
@@ -268,6 +299,9 @@ Evenement ecouteNcurses() {
     case 'R' :
     case 'r' :
       return TOUCHE_R;
+    case 'C' :
+    case 'c' :
+      return TOUCHE_C;
     case ESCAPE :
       return ECHAP;
     default :
@@ -275,56 +309,57 @@ Evenement ecouteNcurses() {
   }
 }
 
+/**
+ * @brief Implémentation de la fonction ecouteNcurses.
+ */
+uint16_t ecouteNcurses(Vue *vue, EvenementDate *evts, uint16_t max) {
+  int64_t date = getDate();
+  uint16_t n = 0;
+  int c;
+  // On lit toutes les touches en attente (getch ne bloque pas)
+  while (n < max && (c = getch()) != ERR)
+    if ((evts[n].evt = convertitToucheNcurses(c)) != RIEN)
+      evts[n++].date = date;
+  return n;
+}
+
 /**
  * @brief Implémentation de la fonction afficherScoreNcurses.
  */
 void rafraichiVueNcurses(Vue *vue) {
   VueNcurses *data = (VueNcurses *)vue->data;
-  int i, j;
-  // rafraichissement des messages
-  wrefresh(data->boxScore);
-  wrefresh(data->boxMessage);
-  // rafraichissement de toutes les cases du terrain du jeu
-  for (i = 0; i < vue->nbLignes; i++)
-    for (j = 0; j < vue->nbColonnes; j++)
-      wrefresh(data->terrain[i * vue->nbColonnes + j]);
-  // rafraichissement de toutes les cases du terrain de la forme suivante
-  for (i = 0; i < DIM; i++)
-    for (j = 0; j < DIM; j++)
-      wrefresh(data->suivante[i * DIM + j]);
+  // On prépare l'écran virtuel avec les messages et les deux terrains
+  wnoutrefresh(data->boxScore);
+  wnoutrefresh(data->boxMessage);
+  wnoutrefresh(data->terrain);
+  wnoutrefresh(data->suivante);
+  // Une seule écriture vers le terminal, avec seulement ce qui a changé
+  doupdate();
 }
 
 /**
- * @brief Implémentation de la fonction metVueAjourNcurses.
+ * @brief Implémentation de la fonction dessineNcurses.
  */
-uint8_t metVueAJourNcurses(Vue *vue,
-                           Modele *modele,
-                           int8_t errEtColl,
-                           uint16_t pause,
-                           uint16_t fini) {
-  if (errEtColl == -1)
+uint8_t dessineNcurses(Vue *vue, const ImageVue *image) {
+  if (image->errEtColl == -1)
     return 1;
-  Couple coords[NB_CASES_FORME];
-  Couleur terrain[vue->nbLignes * vue->nbColonnes];
+  const Image *modele = &image->modele;
 
-  // Si il y'a collision, on dessine la forme suivante
-  if (errEtColl) {
-    getCoordFormeSuivante(modele, coords);
-    dessineFormeSuivanteNcurses(vue, coords, getCouleurFormeSuivante(modele));
-  }
+  // On dessine la forme suivante (des images peuvent être sautées, on ne sait donc pas si elle a
+  // changé depuis la dernière image dessinée)
+  dessineFormeSuivanteNcurses(vue, modele->suivante, modele->couleurSuivante);
   // On dessine le terrain
-  getTerrain(modele, terrain, 0, BASE, vue->nbColonnes, vue->nbLignes);
-  dessineTerrainNcurses(vue, terrain);
-  // On dessine la forme
-  getCoordFormeCourante(modele, coords);
-  dessineFormeNcurses(vue, coords, getCouleurFormeCourante(modele));
+  dessineTerrainNcurses(vue, modele->terrain);
+  // On dessine la forme fantôme puis la forme
+  dessineFormeNcurses(vue, modele->fantome, GRIS);
+  dessineFormeNcurses(vue, modele->forme, modele->couleurForme);
   // On met à jour le score
-  afficheScoreNcurses(vue, getScore(modele));
+  afficheScoreNcurses(vue, modele->score);
 
   // On met le message à jour
-  if (fini) {
+  if (image->fini) {
     afficheMessageNcurses(vue, MSG_FIN);
-  } else if (pause) {
+  } else if (image->pause) {
     afficheMessageNcurses(vue, MSG_PAUSE);
   } else {
     afficheMessageNcurses(vue, MSG_JEU);
@@ -7,7 +7,9 @@
 // Structure de la vue Ncurses
 typedef struct {
   WINDOW *boxJeu, *boxTerrain, *boxSuivante, *boxScore, *boxMessage;
-  WINDOW **terrain, **suivante;
+  // Fenêtres des cases du terrain et de la forme suivante (une case fait HAUT_CASE lignes et
+  // LARG_CASE colonnes)
+  WINDOW *terrain, *suivante;
 } VueNcurses;
 
 /**
@@ -21,15 +23,15 @@ typedef struct {
 WINDOW *creeBox(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
 
 /**
- * @brief Crée un ensemble de case pour le jeu. Une case représente une fenêtre de dimensions
- * HAUT_CASE et LARG_CASE avec un fond de couleur.
+ * @brief Crée une fenêtre pour un ensemble de case du jeu. Une case occupe HAUT_CASE lignes et
+ * LARG_CASE colonnes de la fenêtre, bordées et avec un fond de couleur.
  * @param x représente l'abscisse à laquelle il commence à créer les cases.
  * @param y représente l'ordonnées à laquelle il commence à créer les cases.
  * @param w représente le nombre de case sur une ligne.
  * @param h représente le nombre de case sur une colonne.
- * @return un pointeur vers l'ensemble des cases créées .
+ * @return un pointeur vers la fenêtre des cases ou NULL si il y'a eu erreur.
  */
-WINDOW **creeLesCases(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+WINDOW *creeLesCases(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
 
 /**
  * @brief Crée et initialiser la vue Ncurses du jeu Tetris.
@@ -71,7 +73,7 @@ void dessineCaseSuivanteNcurses(Vue *vue, uint16_t x, uint16_t y, Couleur couleu
  * @param coords représente les coordonnées de la forme sur le terrain.
  * @param couleur représente la couleur utilisée pour dessiner la forme.
  */
-void dessineFormeNcurses(Vue *vue, Couple *coords, Couleur couleur);
+void dessineFormeNcurses(Vue *vue, const Couple *coords, Couleur couleur);
 
 /**
  * @brief Dessine la forme suivante sur le terrain d'affichage de la forme suivante avec la couleur
@@ -80,14 +82,14 @@ void dessineFormeNcurses(Vue *vue, Couple *coords, Couleur couleur);
  * @param coords représente les coordonnées relatives de la forme suivante.
  * @param couleur représente la couleur utilisée pour dessiner la forme.
  */
-void dessineFormeSuivanteNcurses(Vue *vue, Couple *coords, Couleur couleur);
+void dessineFormeSuivanteNcurses(Vue *vue, const Couple *coords, Couleur couleur);
 
 /**
  * @brief Dessine toutes les cases du terrain d'affichage du jeu avec leurs couleurs.
  * @param vue représente la vue Ncurses du jeu.
  * @param terrain représente le terrain du jeu à dessiner.
  */
-void dessineTerrainNcurses(Vue *vue, Couleur *terrain);
+void dessineTerrainNcurses(Vue *vue, const uint8_t *terrain);
 
 /**
  * @brief nettoie le terrain d'affichage de la forme suivante en mettant la couleur NOIR dans toutes
@@ -101,7 +103,7 @@ void nettoieTerrainSuivanteNcurses(Vue *vue);
  * @param vue représente la vue Ncurses du jeu.
  * @param score représente le score du jeu.
  */
-void afficheScoreNcurses(Vue *vue, uint16_t score);
+void afficheScoreNcurses(Vue *vue, uint32_t score);
 
 /**
  * @brief Permet d'afficher un message dans la box des messages.
@@ -111,30 +113,30 @@ void afficheScoreNcurses(Vue *vue, uint16_t score);
 void afficheMessageNcurses(Vue *vue, char *s);
 
 /**
- * @brief Fonction permettant d'ecouter l'évènement lancé par l'utilisateur
- * @return l'évènement correspondant au clic de l'utilisateur.
+ * @brief Fonction permettant d'ecouter tous les évènements lancés par l'utilisateur depuis le
+ * dernier appel. Ncurses ne date pas les touches, elles sont datées au moment de la lecture.
+ * Ncurses n'étant pas réentrant, elle est appelée par le thread d'affichage quand le terminal a
+ * des touches (voir Vue).
+ * @param vue représente la vue Ncurses du jeu.
+ * @param evts représente l'espace où stocker les évènements. (Paramètre modifié)
+ * @param max représente le nombre maximum d'évènements à lire.
+ * @return le nombre d'évènements lus.
  */
-Evenement ecouteNcurses();
+uint16_t ecouteNcurses(Vue *vue, EvenementDate *evts, uint16_t max);
 
 /**
- * @brief rafraichi la vue Ncurses du jeu.
+ * @brief rafraichi la vue Ncurses du jeu : les fenêtres sont préparées avec wnoutrefresh puis le
+ * terminal est mis à jour en une fois avec doupdate.
  * @param vue représente la vue Ncurses du jeu.
  */
 void rafraichiVueNcurses(Vue *vue);
 
 /**
- * @brief Met à jour la vue Ncurses du jeu.
+ * @brief Dessine une image du jeu dans la vue Ncurses (depuis le thread d'affichage).
  * @param vue représente la vue Ncurses du jeu.
- * @param modele représente le modèledu jeu.
- * @param errEtColl représente un entier qui dit si il y'a eu collision ou erreur
- * @param fini représente un booléen qui dit si le jeu est terminé.
- * @param pause représente un booléen qui dit si le jeu est en pause.
+ * @param image représente l'image à dessiner.
  * @return 0 si tout s'est bien passée et 1 si non.
  */
-uint8_t metVueAJourNcurses(Vue *vue,
-                           Modele *modele,
-                           int8_t errEtColl,
-                           uint16_t pause,
-                           uint16_t fini);
+uint8_t dessineNcurses(Vue *vue, const ImageVue *image);
 
-#endif
\ No newline at end of file
+#endif
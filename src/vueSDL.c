@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "vue.h"
 #include "vueSDL.h"
@@ -10,20 +11,26 @@
 #define FEN_HAUT 1080
 // Macro pour la dimanesion d'une case
 #define DIM_CASE 35
-// Macro pour la dimension du terrain de la suivante
-#define DIM 6
 // Macro pour la marge en colonne
 #define MARGE_COL 60
 // Macro pour la marge en ligne
 #define MARGE_LIG 50
+// Macro pour le nombre de couleurs des cases (les couleurs vont de 1 à GRIS)
+#define NB_COULEURS GRIS
 
 /**
  * @brief Implémentation de la fonction initVueSDL.
  */
 Vue *initVueSDL(uint16_t nbLignes, uint16_t nbColonnes) {
   uint16_t x, y;
+#ifdef __APPLE__
+  // Sous macOS, la fenêtre et ses évènements ne peuvent vivre que sur le thread principal alors
+  // qu'ici le thread d'affichage les possède
+  fprintf(stderr, "Erreur à la création de la vue SDL : Vue indisponible sous macOS\n");
+  return NULL;
+#endif
   // Création de la vue
-  Vue *vue = (Vue *)malloc(sizeof(Vue));
+  Vue *vue = (Vue *)calloc(1, sizeof(Vue));
   if (!vue) {
     perror("Erreur à la création de la vue SDL : Allocation mémoire échouée");
     return NULL;
@@ -32,7 +39,7 @@ Vue *initVueSDL(uint16_t nbLignes, uint16_t nbColonnes) {
   vue->nbColonnes = nbColonnes;
 
   // Création des données de la vue
-  VueSDL *data = (VueSDL *)malloc(sizeof(VueSDL));
+  VueSDL *data = (VueSDL *)calloc(1, sizeof(VueSDL));
   if (!data) {
     perror("Erreur à la création de la vue SDL : Allocation mémoire échouée");
     detruitVueSDL(vue);
@@ -40,85 +47,227 @@ Vue *initVueSDL(uint16_t nbLignes, uint16_t nbColonnes) {
   }
   vue->data = data;
 
+  // Initialisation des origines des terrains
+  x = (FEN_LARG - (nbColonnes * DIM_CASE + 3 * MARGE_COL + DIM * DIM_CASE)) / 2;
+  y = (FEN_HAUT - (nbLignes * DIM_CASE + 2 * MARGE_LIG)) / 2;
+  data->oTerrain = (Couple){x + MARGE_COL, y + MARGE_LIG};
+  data->oSuivante =
+      (Couple){x + nbColonnes * DIM_CASE + 2 * MARGE_COL, (FEN_HAUT - DIM * DIM_CASE) / 2};
+
+  // Initialisation du reste des variables
+  // SDL, la fenêtre, le rendu et la file des évènements appartiennent au thread d'affichage : il
+  // les crée, les détruit et transmet les évènements au jeu
+  vue->debutDessin = debutDessinSDL;
+  vue->dessine = dessineSDL;
+  vue->finDessin = finDessinSDL;
+  vue->ecoute = ecouteSDL;
+  vue->entree = -1;
+  vue->attendsEntree = attendsEntreeSDL;
+  vue->reveilleEntree = reveilleEntreeSDL;
+  vue->detruitVue = detruitVueSDL;
+  return vue;
+}
+
+/**
+ * @brief Implémentation de la fonction detruitVueSDL.
+ */
+void detruitVueSDL(Vue *vue) {
+  if (!vue)
+    return;
+  // SDL a déjà été fermée par le thread d'affichage, il ne reste que les mémoires
+  free(vue->data);
+  free(vue);
+}
+
+/**
+ * @brief Dessine dans la cible le fond qui ne change pas (box du jeu et messages) et marque les
+ * cases et le score comme à redessiner.
+ * @param vue représente la vue SDL du jeu.
+ * @return 0 si tout s'est bien passée et 1 si non.
+ */
+static uint8_t dessineFondSDL(Vue *vue) {
+  SDL_Rect rect;
+  VueSDL *data = (VueSDL *)vue->data;
+  if (SDL_SetRenderTarget(data->renderer, data->cible) < 0) {
+    fprintf(stderr, "Erreur lors du changement de cible du rendu : %s\n", SDL_GetError());
+    return 1;
+  }
+  // Couleur de fond de la fenêtre
+  if (SDL_SetRenderDrawColor(data->renderer, 30, 30, 30, 255) < 0) {
+    fprintf(stderr, "Erreur lors du dessin d'un rectangle : %s\n", SDL_GetError());
+    return 1;
+  }
+  if (SDL_RenderClear(data->renderer) < 0) {
+    fprintf(stderr, "Erreur lors du dessin d'un rectangle : %s\n", SDL_GetError());
+    return 1;
+  }
+  // Dessin de la box du jeu
+  rect.w = vue->nbColonnes * DIM_CASE + 3 * MARGE_COL + DIM * DIM_CASE;
+  rect.h = vue->nbLignes * DIM_CASE + 2 * MARGE_LIG;
+  rect.x = (FEN_LARG - rect.w) / 2;
+  rect.y = (FEN_HAUT - rect.h) / 2;
+  if (dessineRectBordures(data, &rect, NOIR, 3))
+    return 1;
+  // Le message ne change pas, il n'est dessiné qu'ici
+  if (afficheMessageSDL(vue))
+    return 1;
+  // Aucune couleur ne vaut 0, toutes les cases seront donc redessinées
+  memset(data->affichees, 0, sizeof(data->affichees));
+  memset(data->suivanteAffichee, 0, sizeof(data->suivanteAffichee));
+  data->scoreAffiche = -1;
+  return 0;
+}
+
+/**
+ * @brief (Re)crée l'atlas des cases : une texture avec une case bordée par couleur, la case de la
+ * couleur c commençant à l'abscisse (c - 1) * DIM_CASE.
+ * @param data représente les données de la vue SDL.
+ * @return 0 si tout s'est bien passée et 1 si non.
+ */
+static uint8_t creeAtlasSDL(VueSDL *data) {
+  SDL_Rect rect;
+  if (data->atlas)
+    SDL_DestroyTexture(data->atlas);
+  data->atlas = SDL_CreateTexture(data->renderer, SDL_PIXELFORMAT_RGBA8888,
+                                  SDL_TEXTUREACCESS_TARGET, NB_COULEURS * DIM_CASE, DIM_CASE);
+  if (!data->atlas) {
+    fprintf(stderr, "Erreur à la création de l'atlas des cases : %s\n", SDL_GetError());
+    return 1;
+  }
+  if (SDL_SetRenderTarget(data->renderer, data->atlas) < 0) {
+    fprintf(stderr, "Erreur lors du changement de cible du rendu : %s\n", SDL_GetError());
+    return 1;
+  }
+  // Le contenu d'une nouvelle texture n'est pas défini, on l'efface avec la couleur de fond de la
+  // fenêtre, que gardent la ligne et la colonne hors des bordures de chaque case
+  if (SDL_SetRenderDrawColor(data->renderer, 30, 30, 30, 255) < 0) {
+    fprintf(stderr, "Erreur lors du dessin d'un rectangle : %s\n", SDL_GetError());
+    return 1;
+  }
+  if (SDL_RenderClear(data->renderer) < 0) {
+    fprintf(stderr, "Erreur lors du dessin d'un rectangle : %s\n", SDL_GetError());
+    return 1;
+  }
+  // Chaque case est dessinée une fois avec ses bordures, qui restent à l'intérieur de la case
+  for (int c = 1; c <= NB_COULEURS; c++) {
+    rect = (SDL_Rect){(c - 1) * DIM_CASE + 1, 1, DIM_CASE - 1, DIM_CASE - 1};
+    if (dessineRectBordures(data, &rect, c, 1))
+      return 1;
+  }
+  return 0;
+}
+
+/**
+ * @brief (Re)crée l'atlas des cases et la texture cible de la taille de la fenêtre, puis y
+ * dessine le fond.
+ * @param vue représente la vue SDL du jeu.
+ * @return 0 si tout s'est bien passée et 1 si non.
+ */
+static uint8_t creeTexturesSDL(Vue *vue) {
+  VueSDL *data = (VueSDL *)vue->data;
+  // Les textes en cache sont perdus avec les autres textures, ils seront rendus à nouveau
+  videTextesSDL(data);
+  if (creeAtlasSDL(data))
+    return 1;
+  if (data->cible)
+    SDL_DestroyTexture(data->cible);
+  data->cible = SDL_CreateTexture(data->renderer, SDL_PIXELFORMAT_RGBA8888,
+                                  SDL_TEXTUREACCESS_TARGET, FEN_LARG, FEN_HAUT);
+  if (!data->cible) {
+    fprintf(stderr, "Erreur à la création de la texture cible : %s\n", SDL_GetError());
+    return 1;
+  }
+  return dessineFondSDL(vue);
+}
+
+/**
+ * @brief Implémentation de la fonction debutDessinSDL.
+ */
+uint8_t debutDessinSDL(Vue *vue) {
+  VueSDL *data = (VueSDL *)vue->data;
   // Initialisation de la SDL
   if (SDL_Init(SDL_INIT_VIDEO) < 0) {
     fprintf(stderr, "Erreur à l'initialisation de SDL : %s\n", SDL_GetError());
-    detruitVueSDL(vue);
-    return NULL;
+    finDessinSDL(vue);
+    return 1;
   }
 
   // Initialisation de TTF pour les textes
   if (TTF_Init() < 0) {
     fprintf(stderr, "Erreur à l'initialisation de SDL_ttf : %s\n", TTF_GetError());
-    detruitVueSDL(vue);
-    return NULL;
+    finDessinSDL(vue);
+    return 1;
+  }
+
+  // Évènement qui réveille ce thread quand le jeu publie une image
+  data->reveil = SDL_RegisterEvents(1);
+  if (data->reveil == (Uint32)-1) {
+    fprintf(stderr, "Erreur à l'initialisation de SDL : %s\n", SDL_GetError());
+    finDessinSDL(vue);
+    return 1;
   }
 
   // Création de la fenêtre du jeu
   data->fenetre = SDL_CreateWindow("Tetris", 0, 0, FEN_LARG, FEN_HAUT, SDL_WINDOW_SHOWN);
   if (!data->fenetre) {
     fprintf(stderr, "Erreur à la création de la fenêtre SDL : %s\n", SDL_GetError());
-    detruitVueSDL(vue);
-    return NULL;
-  }
-
-  // Création d'un rendu pour l'affichage su jeu
-  data->renderer = SDL_CreateRenderer(data->fenetre, -1, SDL_RENDERER_ACCELERATED);
-  if (!data->renderer) {
-    fprintf(stderr, "Erreur à la création du renderer SDL : %s\n", SDL_GetError());
-    detruitVueSDL(vue);
-    return NULL;
+    finDessinSDL(vue);
+    return 1;
   }
 
   // Chargement de la police
   data->police = TTF_OpenFont("police/DejaVuSans.ttf", 30);
   if (!data->police) {
     fprintf(stderr, "Erreur lors du chargement de la police : %s\n", TTF_GetError());
-    detruitVueSDL(vue);
-    return NULL;
+    finDessinSDL(vue);
+    return 1;
   }
 
-  // Initialisation des origines des terrains
-  x = (FEN_LARG - (nbColonnes * DIM_CASE + 3 * MARGE_COL + DIM * DIM_CASE)) / 2;
-  y = (FEN_HAUT - (nbLignes * DIM_CASE + 2 * MARGE_LIG)) / 2;
-  data->oTerrain = (Couple){x + MARGE_COL, y + MARGE_LIG};
-  data->oSuivante =
-      (Couple){x + nbColonnes * DIM_CASE + 2 * MARGE_COL, (FEN_HAUT - DIM * DIM_CASE) / 2};
-
-  // Initialisation du reste des variables
-  vue->metVueAJour = metVueAJourSDL;
-  vue->ecoute = ecouteSDL;
-  vue->detruitVue = detruitVueSDL;
-  return vue;
+  // Création d'un rendu pour l'affichage su jeu, qui peut dessiner dans une texture
+  data->renderer = SDL_CreateRenderer(data->fenetre, -1,
+                                      SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE);
+  if (!data->renderer) {
+    fprintf(stderr, "Erreur à la création du renderer SDL : %s\n", SDL_GetError());
+    finDessinSDL(vue);
+    return 1;
+  }
+  // Création de l'atlas des cases et de la texture où l'image est gardée d'une fois sur l'autre
+  data->aRedessiner = 0;
+  if (creeTexturesSDL(vue)) {
+    finDessinSDL(vue);
+    return 1;
+  }
+  return 0;
 }
 
 /**
- * @brief Implémentation de la fonction detruitVueSDL.
+ * @brief Implémentation de la fonction finDessinSDL.
  */
-void detruitVueSDL(Vue *vue) {
-  if (!vue)
-    return;
+void finDessinSDL(Vue *vue) {
   VueSDL *data = (VueSDL *)vue->data;
-  if (!data) {
-    free(vue);
-    return;
-  }
+  if (data->cible)
+    SDL_DestroyTexture(data->cible);
+  data->cible = NULL;
+  if (data->atlas)
+    SDL_DestroyTexture(data->atlas);
+  data->atlas = NULL;
+  videTextesSDL(data);
   // Destruction du rendu
   if (data->renderer)
     SDL_DestroyRenderer(data->renderer);
+  data->renderer = NULL;
+  // Destruction de la police
+  if (data->police)
+    TTF_CloseFont(data->police);
+  data->police = NULL;
   // Destruction de la fenêtre
   if (data->fenetre)
     SDL_DestroyWindow(data->fenetre);
-  // Destruction de la police
-  if (!data->police)
-    TTF_CloseFont(data->police);
+  data->fenetre = NULL;
   // Clôture du TTF
   TTF_Quit();
   // Clôture de SDL
   SDL_Quit();
-  // Libération des mémoires
-  free(data);
-  free(vue);
 }
 
 /**
@@ -142,6 +291,8 @@ SDL_Color getSDLColor(Couleur couleur) {
       return (SDL_Color){255, 0, 255, 255};
     case CYAN :
       return (SDL_Color){0, 255, 255, 255};
+    case GRIS :
+      return (SDL_Color){80, 80, 80, 255};
     default :
       return (SDL_Color){0, 255, 255, 255};
   }
@@ -191,25 +342,82 @@ uint8_t dessineRectBordures(VueSDL *data, SDL_Rect *rect, Couleur couleur, float
 }
 
 /**
- * @brief Implémentation de la fonction ecritTexte.
+ * @brief Implémentation de la fonction getTexteSDL.
  */
-uint8_t ecritTexte(VueSDL *data, SDL_Rect *rect, char *s) {
+TexteSDL *getTexteSDL(VueSDL *data, const char *s) {
   SDL_Surface *textSurface;
+  TexteSDL *texte;
+  // On cherche le texte dans le cache
+  for (uint8_t i = 0; i < data->nbTextes; i++)
+    if (!strcmp(data->textes[i].texte, s))
+      return &data->textes[i];
+  if (data->nbTextes == MAX_TEXTES || strlen(s) >= MAX_TEXTE) {
+    fprintf(stderr, "Erreur lors de la création du texte \"%s\" : cache des textes plein\n", s);
+    return NULL;
+  }
   // Utilisation d'une surface SDL pour le texte
   textSurface = TTF_RenderText_Blended(data->police, s, getSDLColor(BLANC));
   if (!textSurface) {
     fprintf(stderr, "Erreur lors de la création de la surface de texte : %s\n", TTF_GetError());
-    return 1;
+    return NULL;
   }
-  // Créer une texture SDL à partir de la surface de texte
-  SDL_Texture *textTexture = SDL_CreateTextureFromSurface(data->renderer, textSurface);
-  if (!textTexture) {
+  // Créer une texture SDL à partir de la surface de texte, gardée pour les appels suivants
+  texte = &data->textes[data->nbTextes];
+  texte->texture = SDL_CreateTextureFromSurface(data->renderer, textSurface);
+  texte->w = textSurface->w;
+  texte->h = textSurface->h;
+  SDL_FreeSurface(textSurface);
+  if (!texte->texture) {
     fprintf(stderr, "Erreur lors de la création de la texture de texte : %s\n", SDL_GetError());
-    return 1;
+    return NULL;
   }
-  SDL_FreeSurface(textSurface);
+  strcpy(texte->texte, s);
+  data->nbTextes++;
+  return texte;
+}
+
+/**
+ * @brief Implémentation de la fonction videTextesSDL.
+ */
+void videTextesSDL(VueSDL *data) {
+  for (uint8_t i = 0; i < data->nbTextes; i++)
+    SDL_DestroyTexture(data->textes[i].texture);
+  data->nbTextes = 0;
+}
+
+/**
+ * @brief Implémentation de la fonction ecritTexte.
+ */
+uint8_t ecritTexte(VueSDL *data, SDL_Rect *rect, const char *s) {
+  TexteSDL *texte = getTexteSDL(data, s);
+  if (!texte)
+    return 1;
   // Afficher la texture de texte
-  SDL_RenderCopy(data->renderer, textTexture, NULL, rect);
+  if (SDL_RenderCopy(data->renderer, texte->texture, NULL, rect) < 0) {
+    fprintf(stderr, "Erreur lors de l'affichage d'un texte : %s\n", SDL_GetError());
+    return 1;
+  }
+  return 0;
+}
+
+/**
+ * @brief Copie la case de l'atlas de la couleur spécifiée à la position (x, y) de la fenêtre.
+ * @param data représente les données de la vue SDL.
+ * @param x représente l'abscisse de la case dans la fenêtre.
+ * @param y représente l'ordonnée de la case dans la fenêtre.
+ * @param couleur représente la couleur de la case.
+ * @return 0 si tout s'est bien passée et 1 si non.
+ */
+static uint8_t copieCaseSDL(VueSDL *data, int x, int y, Couleur couleur) {
+  SDL_Rect source = {(couleur - 1) * DIM_CASE, 0, DIM_CASE, DIM_CASE};
+  SDL_Rect rect = {x, y, DIM_CASE, DIM_CASE};
+  // Une couleur inconnue est dessinée comme le reste du terrain
+  if (couleur < 1 || couleur > NB_COULEURS)
+    source.x = (NOIR - 1) * DIM_CASE;
+  if (SDL_RenderCopy(data->renderer, data->atlas, &source, &rect) < 0) {
+    fprintf(stderr, "Erreur lors de la copie d'une case : %s\n", SDL_GetError());
+    return 1;
+  }
   return 0;
 }
 
@@ -217,82 +425,89 @@ uint8_t ecritTexte(VueSDL *data, SDL_Rect *rect, char *s) {
  * @brief Implémentation de la fonction dessineCaseSDL.
  */
 uint8_t dessineCaseSDL(Vue *vue, uint16_t x, uint16_t y, Couleur couleur) {
-  SDL_Rect rect;
-  rect.x = ((VueSDL *)vue->data)->oTerrain.x + x * DIM_CASE;
-  rect.y = ((VueSDL *)vue->data)->oTerrain.y + y * DIM_CASE;
-  rect.w = DIM_CASE;
-  rect.h = DIM_CASE;
-  return dessineRectBordures(((VueSDL *)vue->data), &rect, couleur, 0.5);
+  VueSDL *data = (VueSDL *)vue->data;
+  return copieCaseSDL(data, data->oTerrain.x + x * DIM_CASE, data->oTerrain.y + y * DIM_CASE,
+                      couleur);
 }
 
 /**
  * @brief Implémentation de la fonction dessineCaseSuivanteSDL.
  */
 uint8_t dessineCaseSuivanteSDL(Vue *vue, uint16_t x, uint16_t y, Couleur couleur) {
-  SDL_Rect rect;
-  rect.x = ((VueSDL *)vue->data)->oSuivante.x + x * DIM_CASE;
-  rect.y = ((VueSDL *)vue->data)->oSuivante.y + y * DIM_CASE;
-  rect.w = DIM_CASE;
-  rect.h = DIM_CASE;
-  return dessineRectBordures(((VueSDL *)vue->data), &rect, couleur, 0.5);
+  VueSDL *data = (VueSDL *)vue->data;
+  return copieCaseSDL(data, data->oSuivante.x + x * DIM_CASE, data->oSuivante.y + y * DIM_CASE,
+                      couleur);
 }
 
 /**
- * @brief Implémentation de la fonction dessineFormeSDL.
+ * @brief Pose une forme dans une grille de couleurs.
+ * @param cases représente la grille de couleurs. (Paramètre modifié)
+ * @param largeur représente le nombre de colonnes de la grille.
+ * @param hauteur représente le nombre de lignes de la grille.
+ * @param coords représente les coordonnées de la forme dans la grille.
+ * @param couleur représente la couleur de la forme.
  */
-uint8_t dessineFormeSDL(Vue *vue, Couple *coords, Couleur couleur) {
-  // On parcours les coordonées
+static void poseForme(uint8_t *cases, uint16_t largeur, uint16_t hauteur, const Couple *coords,
+                      Couleur couleur) {
   for (int i = 0; i < NB_CASES_FORME; i++)
-    // On vérifie si la forme ne deborde pas sur la base
-    if (0 <= coords[i].y - BASE)
-      if (dessineCaseSDL(vue, coords[i].x, coords[i].y - BASE, couleur))
-        return 1;
-  return 0;
+    if (0 <= coords[i].x && coords[i].x < largeur && 0 <= coords[i].y && coords[i].y < hauteur)
+      cases[coords[i].y * largeur + coords[i].x] = couleur;
 }
 
 /**
  * @brief Implémentation de la fonction dessineFormeSuivanteSDL.
  */
-uint8_t dessineFormeSuivanteSDL(Vue *vue, Couple *coords, Couleur couleur) {
-  // Nettoie le terrain de la forme suivante
-  nettoieTerrainSuivanteSDL(vue);
-  // On parcours les coordonées et on dessine
-  for (int i = 0; i < NB_CASES_FORME; i++)
-    if (dessineCaseSuivanteSDL(vue, coords[i].x + 2, coords[i].y + 2, couleur))
-      return 1;
-  return 0;
-}
-
-/**
- * @brief Implémentation de la fonction dessineTerrainSDL.
- */
-uint8_t dessineTerrainSDL(Vue *vue, Couleur *terrain) {
-  int i, j;
-  // On parcours et on dessine
-  for (i = 0; i < vue->nbLignes; i++)
-    for (j = 0; j < vue->nbColonnes; j++)
-      if (dessineCaseSDL(vue, j, i, terrain[i * vue->nbColonnes + j]))
+uint8_t dessineFormeSuivanteSDL(Vue *vue, const Couple *coords, Couleur couleur) {
+  VueSDL *data = (VueSDL *)vue->data;
+  uint8_t voulues[DIM * DIM];
+  Couple decalees[NB_CASES_FORME];
+  int i;
+  // On compose le terrain de la suivante : la forme centrée sur du NOIR
+  memset(voulues, NOIR, sizeof(voulues));
+  for (i = 0; i < NB_CASES_FORME; i++)
+    decalees[i] = (Couple){coords[i].x + 2, coords[i].y + 2};
+  poseForme(voulues, DIM, DIM, decalees, couleur);
+  // On ne redessine que les cases qui ont changé
+  for (i = 0; i < DIM * DIM; i++)
+    if (voulues[i] != data->suivanteAffichee[i]) {
+      if (dessineCaseSuivanteSDL(vue, i % DIM, i / DIM, voulues[i]))
         return 1;
+      data->suivanteAffichee[i] = voulues[i];
+    }
   return 0;
 }
 
 /**
- * @brief Implémentation de la fonction nettoieTerrainSuivante.
+ * @brief Implémentation de la fonction dessineTerrainSDL.
  */
-uint8_t nettoieTerrainSuivanteSDL(Vue *vue) {
-  int i, j;
-  // On parcours et on nettoie
-  for (i = 0; i < DIM; i++)
-    for (j = 0; j < DIM; j++)
-      if (dessineCaseSuivanteSDL(vue, j, i, NOIR))
+uint8_t dessineTerrainSDL(Vue *vue, const Image *image) {
+  VueSDL *data = (VueSDL *)vue->data;
+  uint8_t voulues[MAX_LIGNES * MAX_COLONNES];
+  Couple coords[NB_CASES_FORME];
+  int i, n = vue->nbLignes * vue->nbColonnes;
+  // On compose le terrain voulu : les cases posées, la forme fantôme puis la forme (sans la base)
+  memcpy(voulues, image->terrain, n);
+  for (i = 0; i < NB_CASES_FORME; i++)
+    coords[i] = (Couple){image->fantome[i].x, image->fantome[i].y - BASE};
+  poseForme(voulues, vue->nbColonnes, vue->nbLignes, coords, GRIS);
+  for (i = 0; i < NB_CASES_FORME; i++)
+    coords[i] = (Couple){image->forme[i].x, image->forme[i].y - BASE};
+  poseForme(voulues, vue->nbColonnes, vue->nbLignes, coords, image->couleurForme);
+  // On ne redessine que les cases qui ont changé, dont les anciennes et nouvelles places de la
+  // forme
+  for (i = 0; i < n; i++)
+    if (voulues[i] != data->affichees[i]) {
+      if (dessineCaseSDL(vue, i % vue->nbColonnes, i / vue->nbColonnes, voulues[i]))
         return 1;
+      data->affichees[i] = voulues[i];
+    }
   return 0;
 }
 
 /**
  * @brief Implémentation de la fonction afficheScoreSDL.
  */
-uint8_t afficheScoreSDL(Vue *vue, uint16_t score) {
+uint8_t afficheScoreSDL(Vue *vue, uint32_t score) {
   SDL_Rect rect;
   VueSDL *data = (VueSDL *)vue->data;
   rect.x = data->oSuivante.x;
@@ -301,13 +516,33 @@ uint8_t afficheScoreSDL(Vue *vue, uint16_t score) {
   rect.h = DIM_CASE;
   if (dessineRectBordures(data, &rect, NOIR, 0.5))
     return 1;
-  char s[25];
-  sprintf(s, "S C O R E : %d", score);
+  // Le score est composé du début du texte et des chiffres, chacun rendu une seule fois
+  TexteSDL *morceaux[1 + 10];
+  char chiffres[11], chiffre[2] = {0};
+  int i, n, largeur = 0;
+  if (!(morceaux[0] = getTexteSDL(data, "S C O R E : ")))
+    return 1;
+  n = sprintf(chiffres, "%u", score);
+  for (i = 0; i < n; i++) {
+    chiffre[0] = chiffres[i];
+    if (!(morceaux[i + 1] = getTexteSDL(data, chiffre)))
+      return 1;
+  }
+  for (i = 0; i <= n; i++)
+    largeur += morceaux[i]->w;
+  // Le texte entier est étiré dans le rectangle, chaque morceau à proportion de sa largeur
   rect.x = rect.x + rect.w / 8;
   rect.y = rect.y + rect.h / 8;
-  rect.w = 6 * rect.w / 8;
-  rect.h = 6 * rect.h / 8;
-  return ecritTexte(data, &rect, s);
+  SDL_Rect dest = {rect.x, rect.y, 0, 6 * rect.h / 8};
+  for (i = 0; i <= n; i++) {
+    dest.w = morceaux[i]->w * (6 * rect.w / 8) / largeur;
+    if (SDL_RenderCopy(data->renderer, morceaux[i]->texture, NULL, &dest) < 0) {
+      fprintf(stderr, "Erreur lors de l'affichage d'un texte : %s\n", SDL_GetError());
+      return 1;
+    }
+    dest.x += dest.w;
+  }
+  return 0;
 }
 
 /**
@@ -319,7 +554,7 @@ uint8_t afficheMessageSDL(Vue *vue) {
   rect.x = data->oSuivante.x;
   rect.y = data->oSuivante.y + (DIM + 1) * DIM_CASE + 2 * MARGE_LIG - 5;
   rect.w = DIM * DIM_CASE;
-  rect.h = 5 * (3 * DIM_CASE / 4) + 10;
+  rect.h = 6 * (3 * DIM_CASE / 4) + 10;
   if (dessineRectBordures(data, &rect, NOIR, 0.5))
     return 1;
   rect.x += 10;
@@ -332,6 +567,9 @@ uint8_t afficheMessageSDL(Vue *vue) {
   if (ecritTexte(data, &rect, "ESPACE pour tourner"))
     return 1;
   rect.y = rect.y + rect.h;
+  if (ecritTexte(data, &rect, "C pour faire chuter"))
+    return 1;
+  rect.y = rect.y + rect.h;
   if (ecritTexte(data, &rect, "ENTREE pour pauser/jouer"))
     return 1;
   rect.y = rect.y + rect.h;
@@ -343,89 +581,122 @@ uint8_t afficheMessageSDL(Vue *vue) {
   return 0;
 }
 
+/**
+ * @brief Convertit un évènement SDL en évènement du jeu.
+ * @param event représente l'évènement SDL.
+ * @return l'évènement correspondant (RIEN si il ne sert pas au jeu).
+ */
+static Evenement convertitEvenementSDL(SDL_Event *event) {
+  switch (event->type) {
+    case SDL_QUIT :
+      return ECHAP;
+    case SDL_KEYDOWN :
+      switch (event->key.keysym.sym) {
+        case SDLK_UP :
+          return FHAUT;
+        case SDLK_DOWN :
+          return FBAS;
+        case SDLK_LEFT :
+          return FGAUCHE;
+        case SDLK_RIGHT :
+          return FDROITE;
+        case SDLK_SPACE :
+          return ESPACE;
+        case SDLK_RETURN :
+        case SDLK_KP_ENTER :
+          return ENTREE;
+        case SDLK_r :
+          return TOUCHE_R;
+        case SDLK_c :
+          return TOUCHE_C;
+        case SDLK_ESCAPE :
+          return ECHAP;
+        default :
+          return RIEN;
+      }
+    default :
+      return RIEN;
+  }
+}
+
 /**
  * @brief Implémentation de la fonction ecouteSDL.
  */
-Evenement ecouteSDL() {
+uint16_t ecouteSDL(Vue *vue, EvenementDate *evts, uint16_t max) {
+  int64_t date = getDate();
+  uint32_t ticks = SDL_GetTicks();
   SDL_Event event;
-  if (SDL_PollEvent(&event))
-    switch (event.type) {
-      case SDL_QUIT :
-        return ECHAP;
-      case SDL_KEYDOWN :
-        switch (event.key.keysym.sym) {
-          case SDLK_UP :
-            return FHAUT;
-          case SDLK_DOWN :
-            return FBAS;
-          case SDLK_LEFT :
-            return FGAUCHE;
-          case SDLK_RIGHT :
-            return FDROITE;
-          case SDLK_SPACE :
-            return ESPACE;
-          case SDLK_RETURN :
-          case SDLK_KP_ENTER :
-            return ENTREE;
-          case SDLK_r :
-            return TOUCHE_R;
-          case SDLK_ESCAPE :
-            return ECHAP;
-          default :
-            return RIEN;
-        }
-    }
-  return RIEN;
+  uint16_t n = 0;
+  // On vide la file des évènements, la date de chacun est ramenée de l'horloge de SDL (en ms) à
+  // celle du jeu
+  while (n < max && SDL_PollEvent(&event)) {
+    // Le contenu de la cible est perdu, il faudra tout redessiner
+    if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET)
+      ((VueSDL *)vue->data)->aRedessiner = 1;
+    if ((evts[n].evt = convertitEvenementSDL(&event)) != RIEN)
+      evts[n++].date = date - (int64_t)(ticks - event.common.timestamp) * 1000000;
+  }
+  return n;
+}
+
+/**
+ * @brief Implémentation de la fonction attendsEntreeSDL.
+ */
+void attendsEntreeSDL(Vue *vue) {
+  // L'évènement reste dans la file, ecouteSDL le retire ensuite avec les autres
+  SDL_WaitEvent(NULL);
+}
+
+/**
+ * @brief Implémentation de la fonction reveilleEntreeSDL.
+ */
+void reveilleEntreeSDL(Vue *vue) {
+  // Si la file est pleine, le thread d'affichage a de toute façon un évènement à lire
+  SDL_PushEvent(&(SDL_Event){.type = ((VueSDL *)vue->data)->reveil});
 }
 
 /**
- * @brief Implémentation de la fonction metVueAjourSDL.
+ * @brief Implémentation de la fonction dessineSDL.
  */
-uint8_t metVueAJourSDL(Vue *vue, Modele *modele, int8_t errEtColl, uint16_t pause, uint16_t fini) {
-  if (errEtColl == -1)
+uint8_t dessineSDL(Vue *vue, const ImageVue *image) {
+  if (image->errEtColl == -1)
     return 1;
-  Couple coords[NB_CASES_FORME];
-  Couleur terrain[vue->nbLignes * vue->nbColonnes];
-  SDL_Rect rect;
+  const Image *modele = &image->modele;
   VueSDL *data = (VueSDL *)vue->data;
 
-  // Couleur de fond de la fenêtre
-  if (SDL_SetRenderDrawColor(data->renderer, 30, 30, 30, 255) < 0) {
-    fprintf(stderr, "Erreur lors du dessin d'un rectangle : %s\n", SDL_GetError());
-    return 1;
+  // Si le contenu des textures a été perdu, on les recrée avec le fond
+  if (data->aRedessiner) {
+    data->aRedessiner = 0;
+    if (creeTexturesSDL(vue))
+      return 1;
   }
-  if (SDL_RenderClear(data->renderer) < 0) {
-    fprintf(stderr, "Erreur lors du dessin d'un rectangle : %s\n", SDL_GetError());
+  // On dessine dans la cible ce qui a changé depuis l'image précédente
+  if (SDL_SetRenderTarget(data->renderer, data->cible) < 0) {
+    fprintf(stderr, "Erreur lors du changement de cible du rendu : %s\n", SDL_GetError());
     return 1;
   }
-
-  // Dessin de la box du jeu
-  rect.w = vue->nbColonnes * DIM_CASE + 3 * MARGE_COL + DIM * DIM_CASE;
-  rect.h = vue->nbLignes * DIM_CASE + 2 * MARGE_LIG;
-  rect.x = (FEN_LARG - rect.w) / 2;
-  rect.y = (FEN_HAUT - rect.h) / 2;
-  if (dessineRectBordures(data, &rect, NOIR, 3))
-    return 1;
-
-  // On dessine le terrain
-  getTerrain(modele, terrain, 0, BASE, vue->nbColonnes, vue->nbLignes);
-  if (dessineTerrainSDL(vue, terrain))
-    return 1;
-  // On dessine la forme
-  getCoordFormeCourante(modele, coords);
-  if (dessineFormeSDL(vue, coords, getCouleurFormeCourante(modele)))
+  // On dessine le terrain avec la forme fantôme et la forme
+  if (dessineTerrainSDL(vue, modele))
     return 1;
   // On dessine la forme suivante
-  getCoordFormeSuivante(modele, coords);
-  if (dessineFormeSuivanteSDL(vue, coords, getCouleurFormeSuivante(modele)))
-    return 1;
-  // On met à jour le score
-  if (afficheScoreSDL(vue, getScore(modele)))
+  if (dessineFormeSuivanteSDL(vue, modele->suivante, modele->couleurSuivante))
     return 1;
+  // On met à jour le score si il a changé
+  if (modele->score != data->scoreAffiche) {
+    if (afficheScoreSDL(vue, modele->score))
+      return 1;
+    data->scoreAffiche = modele->score;
+  }
 
-  // On met le message à jour
-  if (afficheMessageSDL(vue))
+  // On copie la cible dans la fenêtre
+  if (SDL_SetRenderTarget(data->renderer, NULL) < 0) {
+    fprintf(stderr, "Erreur lors du changement de cible du rendu : %s\n", SDL_GetError());
     return 1;
-  SDL_RenderPresent(((VueSDL *)vue->data)->renderer);
+  }
+  if (SDL_RenderCopy(data->renderer, data->cible, NULL, NULL) < 0) {
+    fprintf(stderr, "Erreur lors de la copie de la texture cible : %s\n", SDL_GetError());
+    return 1;
+  }
+  SDL_RenderPresent(data->renderer);
   return 0;
-}
\ No newline at end of file
+}
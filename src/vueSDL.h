@@ -5,16 +5,48 @@
 #include <SDL2/SDL_ttf.h>
 #include "vue.h"
 
+// Macro pour la dimension du terrain de la suivante
+#define DIM 6
+// Macro pour le nombre de textes gardés en texture (messages, début du score et chiffres)
+#define MAX_TEXTES 32
+// Macro pour la taille maximale d'un texte gardé en texture
+#define MAX_TEXTE 32
+
+// Structure d'un texte rendu une fois dans une texture
+typedef struct {
+  char texte[MAX_TEXTE];
+  SDL_Texture *texture;
+  int w, h;
+} TexteSDL;
+
 // Structure de la vue SDL
 typedef struct {
   Couple oTerrain, oSuivante;
   SDL_Window *fenetre;
   SDL_Renderer *renderer;
   TTF_Font *police;
+  // Texture qui garde la fenêtre d'une image à l'autre : seules les cases qui changent y sont
+  // redessinées
+  SDL_Texture *cible;
+  // Atlas des cases : une case bordée par couleur, copiée telle quelle pour chaque case dessinée
+  SDL_Texture *atlas;
+  // Cache des textes déjà rendus, cherchés par leur contenu
+  TexteSDL textes[MAX_TEXTES];
+  uint8_t nbTextes;
+  // Couleurs des cases dessinées dans la cible (0 si la case est à redessiner) et score affiché
+  // (-1 si il est à redessiner)
+  uint8_t affichees[MAX_LIGNES * MAX_COLONNES], suivanteAffichee[DIM * DIM];
+  int64_t scoreAffiche;
+  // 1 si le contenu de la cible a été perdu (mis par ecouteSDL, lu par dessineSDL)
+  uint8_t aRedessiner;
+  // Type de l'évènement SDL qui réveille le thread d'affichage
+  Uint32 reveil;
 } VueSDL;
 
 /**
- * @brief Crée et initialiser la vue SDL du jeu Tetris.
+ * @brief Crée et initialiser la vue SDL du jeu Tetris. SDL n'est pas encore initialisée : elle
+ * l'est par le thread d'affichage (debutDessinSDL). La vue SDL n'est pas disponible sous macOS, où
+ * la fenêtre et ses évènements doivent rester sur le thread principal.
  * @param nbLignes représente le nombre de lignes du terrain du jeu.
  * @param nbColonnes représente le nombre de colonnes du terrain du jeu.
  * @return un pointeur vers la vue ou NULL si il y'a eu erreur
@@ -22,11 +54,28 @@ typedef struct {
 Vue *initVueSDL(uint16_t nbLignes, uint16_t nbColonnes);
 
 /**
- * @brief Détruit et libère l'espace occupée par la vue SDL du jeu.
+ * @brief Détruit et libère l'espace occupée par la vue SDL du jeu (SDL a été fermée par
+ * finDessinSDL).
  * @param vue représente la vue SDL à détruire.
  */
 void detruitVueSDL(Vue *vue);
 
+/**
+ * @brief Initialise SDL et SDL_ttf, crée la fenêtre, la police, le rendu SDL, l'atlas des cases et
+ * la texture cible depuis le thread d'affichage, qui possède seul la fenêtre et sa file
+ * d'évènements. En cas d'erreur, ce qui a été créé est détruit.
+ * @param vue représente la vue SDL du jeu.
+ * @return 0 si tout s'est bien passée et 1 si non.
+ */
+uint8_t debutDessinSDL(Vue *vue);
+
+/**
+ * @brief Détruit les textures, le rendu, la police et la fenêtre puis ferme SDL depuis le thread
+ * d'affichage qui les a créés.
+ * @param vue représente la vue SDL du jeu.
+ */
+void finDessinSDL(Vue *vue);
+
 /**
  * @brief Permet d'avoir la couleur correspondante à l'une des énumérations de couleurs.
  * @param couleur représente la couleur de fond du rectangle à dessiner.
@@ -42,18 +91,32 @@ SDL_Color getSDLColor(Couleur couleur);
  */
 uint8_t dessineRectBordures(VueSDL *data, SDL_Rect *rect, Couleur couleur, float epais);
 
+/**
+ * @brief Donne la texture du texte en paramètre, rendue au premier appel puis gardée en cache.
+ * @param data représente les données de la vue SDL.
+ * @param s représente le string contenant le texte (moins de MAX_TEXTE caractères).
+ * @return le texte en cache ou NULL si il y'a eu erreur.
+ */
+TexteSDL *getTexteSDL(VueSDL *data, const char *s);
+
+/**
+ * @brief Détruit les textures des textes en cache.
+ * @param data représente les données de la vue SDL.
+ */
+void videTextesSDL(VueSDL *data);
+
 /**
  * @brief Permet d'ecrire le texte en paramètre dans le rectangle spécifiée.
  * @param rect représente les dimensions du rectangle à dessiner.
  * @param s représente le string contenant le texte.
- * @param epais représente l'épaisseur des bordures du rectangle à dessiner.
+ * @return 0 si tout s'est bien passée et 1 si non.
  */
-uint8_t ecritTexte(VueSDL *data, SDL_Rect *rect, char *s);
+uint8_t ecritTexte(VueSDL *data, SDL_Rect *rect, const char *s);
 
 
 /**
- * @brief Dessine la case (x, y) du terrain d'affichage du jeu en mettant la couleur spécifiée comme
- * couleur de fond.
+ * @brief Dessine la case (x, y) du terrain d'affichage du jeu en copiant la case de l'atlas de la
+ * couleur spécifiée.
  * @param vue représente la vue SDL du jeu.
  * @param x représente le numéro de colonne de la case.
  * @param y représente le numéro de ligne de la case.
@@ -62,8 +125,8 @@ uint8_t ecritTexte(VueSDL *data, SDL_Rect *rect, char *s);
 uint8_t dessineCaseSDL(Vue *vue, uint16_t x, uint16_t y, Couleur couleur);
 
 /**
- * @brief Dessine la case (x, y) du terrain d'affichage de la forme suivante en mettant la couleur
- * spécifiée comme couleur de fond.
+ * @brief Dessine la case (x, y) du terrain d'affichage de la forme suivante en copiant la case de
+ * l'atlas de la couleur spécifiée.
  * @param vue représente la vue SDL du jeu.
  * @param x représente le numéro de colonne de la case.
  * @param y représente le numéro de ligne de la case.
@@ -72,65 +135,71 @@ uint8_t dessineCaseSDL(Vue *vue, uint16_t x, uint16_t y, Couleur couleur);
 uint8_t dessineCaseSuivanteSDL(Vue *vue, uint16_t x, uint16_t y, Couleur couleur);
 
 /**
- * @brief Dessine la forme courante sur le terrain d'affichage du jeu avec la couleur spécifiée.
+ * @brief Dessine la forme suivante sur le terrain d'affichage de la forme suivante avec la couleur
+ * spécifiée. Seules les cases qui ont changé depuis la dernière image sont redessinées.
  * @param vue représente la vue SDL du jeu.
- * @param coords représente les coordonnées de la forme sur le terrain.
+ * @param coords représente les coordonnées relatives de la forme suivante.
  * @param couleur représente la couleur utilisée pour dessiner la forme.
  */
-uint8_t dessineFormeSDL(Vue *vue, Couple *coords, Couleur couleur);
+uint8_t dessineFormeSuivanteSDL(Vue *vue, const Couple *coords, Couleur couleur);
 
 /**
- * @brief Dessine la forme suivante sur le terrain d'affichage de la forme suivante avec la couleur
- * spécifiée.
+ * @brief Dessine le terrain d'affichage du jeu avec la forme fantôme et la forme courante. Seules
+ * les cases qui ont changé depuis la dernière image sont redessinées (dont les anciennes et les
+ * nouvelles positions de la forme).
  * @param vue représente la vue SDL du jeu.
- * @param coords représente les coordonnées relatives de la forme suivante.
- * @param couleur représente la couleur utilisée pour dessiner la forme.
+ * @param image représente l'image du modèle à dessiner.
  */
-uint8_t dessineFormeSuivanteSDL(Vue *vue, Couple *coords, Couleur couleur);
+uint8_t dessineTerrainSDL(Vue *vue, const Image *image);
 
 /**
- * @brief Dessine toutes les cases du terrain d'affichage du jeu avec leurs couleurs.
+ * @brief Met à jour le score sur la vue du jeu. Le score est composé des textures en cache du
+ * début du texte et des chiffres.
  * @param vue représente la vue SDL du jeu.
- * @param terrain représente le terrain du jeu à dessiner.
+ * @param score représente le score du jeu.
  */
-uint8_t dessineTerrainSDL(Vue *vue, Couleur *terrain);
+uint8_t afficheScoreSDL(Vue *vue, uint32_t score);
 
 /**
- * @brief nettoie le terrain d'affichage de la forme suivante en mettant la couleur NOIR dans toutes
- * les cases.
+ * @brief Permet d'afficher un message dans la box des messages.
  * @param vue représente la vue SDL du jeu.
+ * @param s représente le message à afficher.
  */
-uint8_t nettoieTerrainSuivanteSDL(Vue *vue);
+uint8_t afficheMessageSDL(Vue *vue);
 
 /**
- * @brief Met à jour le score sur la vue du jeu.
+ * @brief Fonction permettant d'ecouter tous les évènements lancés par l'utilisateur depuis le
+ * dernier appel, datés avec l'heure où SDL les a reçus. Elle est appelée par le thread d'affichage
+ * (celui qui a initialisé SDL), qui transmet les évènements au jeu. Si le contenu des textures a
+ * été perdu, elle demande de tout redessiner.
  * @param vue représente la vue SDL du jeu.
- * @param score représente le score du jeu.
+ * @param evts représente l'espace où stocker les évènements. (Paramètre modifié)
+ * @param max représente le nombre maximum d'évènements à lire.
+ * @return le nombre d'évènements lus.
  */
-uint8_t afficheScoreSDL(Vue *vue, uint16_t score);
+uint16_t ecouteSDL(Vue *vue, EvenementDate *evts, uint16_t max);
 
 /**
- * @brief Permet d'afficher un message dans la box des messages.
+ * @brief Attend, dans le thread d'affichage, qu'un évènement arrive dans la file de SDL sans le
+ * retirer (évènement du joueur ou réveil par le jeu).
  * @param vue représente la vue SDL du jeu.
- * @param s représente le message à afficher.
  */
-uint8_t afficheMessageSDL(Vue *vue);
+void attendsEntreeSDL(Vue *vue);
 
 /**
- * @brief Fonction permettant d'ecouter l'évènement lancé par l'utilisateur
- * @return l'évènement correspondant au clic de l'utilisateur.
+ * @brief Réveille le thread d'affichage en glissant un évènement de réveil dans la file de SDL.
+ * Elle est appelée par le jeu.
+ * @param vue représente la vue SDL du jeu.
  */
-Evenement ecouteSDL();
+void reveilleEntreeSDL(Vue *vue);
 
 /**
- * @brief Met à jour la vue Ncurses du jeu.
+ * @brief Dessine une image du jeu dans la vue SDL (depuis le thread d'affichage). Elle met à jour
+ * la texture cible avec ce qui a changé depuis l'image précédente puis la copie dans la fenêtre.
  * @param vue représente la vue SDL du jeu.
- * @param modele représente le modèle du jeu.
- * @param errEtColl représente un entier qui dit si il y'a eu collision ou erreur
- * @param fini représente un booléen qui dit si le jeu est terminé.
- * @param pause représente un booléen qui dit si le jeu est en pause.
+ * @param image représente l'image à dessiner.
  * @return 0 si tout s'est bien passée et 1 si non.
  */
-uint8_t metVueAJourSDL(Vue *vue, Modele *modele, int8_t errEtColl, uint16_t fini, uint16_t pause);
+uint8_t dessineSDL(Vue *vue, const ImageVue *image);
 
-#endif
\ No newline at end of file
+#endif